@@ -1,7 +1,7 @@
 use serde::{Deserialize, Serialize};
 
 /// Simplified detection record emitted by the processing pipeline.
-#[derive(Debug, Clone, Serialize, Deserialize)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct DetectionRecord {
     pub timestamp: f64,
     pub range: f32,
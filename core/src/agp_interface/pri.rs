@@ -11,7 +11,7 @@ pub enum PriType {
 }
 
 /// Describes the operational context for a generated or ingested PRI.
-#[derive(Debug, Clone, Serialize, Deserialize)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct ScenarioMetadata {
     pub name: String,
     pub platform_type: String,
@@ -1,9 +1,28 @@
 use crate::prelude::StageError;
+use serde::Serialize;
+
+/// Lifetime counters for a pool; `reset` drops the buffers but keeps these.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq, Serialize)]
+pub struct BufferPoolStats {
+    pub checkouts: u64,
+    /// Checkouts served from a released buffer instead of a fresh allocation.
+    pub reused: u64,
+    pub exhausted: u64,
+}
+
+impl BufferPoolStats {
+    pub fn merge(&mut self, other: BufferPoolStats) {
+        self.checkouts += other.checkouts;
+        self.reused += other.reused;
+        self.exhausted += other.exhausted;
+    }
+}
 
 /// Simple scoped buffer pool that prevents unbounded allocations.
 pub struct BufferPool {
     buffers: Vec<Vec<f32>>,
     max_capacity: usize,
+    stats: BufferPoolStats,
 }
 
 impl BufferPool {
@@ -11,6 +30,7 @@ impl BufferPool {
         Self {
             buffers: Vec::with_capacity(max_capacity),
             max_capacity,
+            stats: BufferPoolStats::default(),
         }
     }
 
@@ -18,10 +38,14 @@ impl BufferPool {
     pub fn checkout(&mut self, length: usize) -> Result<Vec<f32>, StageError> {
         if let Some(mut buffer) = self.buffers.pop() {
             buffer.resize(length, 0.0);
+            self.stats.checkouts += 1;
+            self.stats.reused += 1;
             Ok(buffer)
         } else if self.buffers.len() < self.max_capacity {
+            self.stats.checkouts += 1;
             Ok(vec![0.0; length])
         } else {
+            self.stats.exhausted += 1;
             Err(StageError::BufferExhaustion("pool depleted".to_string()))
         }
     }
@@ -37,4 +61,36 @@ impl BufferPool {
     pub fn reset(&mut self) {
         self.buffers.clear();
     }
+
+    pub fn stats(&self) -> BufferPoolStats {
+        self.stats
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn buffer_pool_counts_checkouts_reuse_and_exhaustion() {
+        let mut pool = BufferPool::with_capacity(1);
+        let buffer = pool.checkout(8).unwrap();
+        pool.release(buffer);
+        let _reused = pool.checkout(4).unwrap();
+
+        let mut empty = BufferPool::with_capacity(0);
+        assert!(empty.checkout(4).is_err());
+
+        assert_eq!(
+            pool.stats(),
+            BufferPoolStats {
+                checkouts: 2,
+                reused: 1,
+                exhausted: 0
+            }
+        );
+        assert_eq!(empty.stats().exhausted, 1);
+        pool.reset();
+        assert_eq!(pool.stats().checkouts, 2);
+    }
 }
@@ -3,7 +3,7 @@ use crate::math::stats::StatsHelper;
 use crate::prelude::{
     ProcessingStage, StageConfig, StageError, StageInput, StageMetadata, StageOutput, StageResult,
 };
-use crate::processing::buffer_pool::BufferPool;
+use crate::processing::buffer_pool::{BufferPool, BufferPoolStats};
 use crate::telemetry::log::LogManager;
 
 /// Clutter/detection stage that wraps the final processing step.
@@ -21,6 +21,11 @@ impl ClutterStage {
             logger: LogManager::new(),
         }
     }
+
+    /// Counters of this stage's buffer pool, kept across `cleanup`.
+    pub fn pool_stats(&self) -> BufferPoolStats {
+        self.pool.stats()
+    }
 }
 
 impl ProcessingStage for ClutterStage {
@@ -3,7 +3,7 @@ pub mod clutter;
 pub mod doppler;
 pub mod range;
 
-pub use buffer_pool::BufferPool;
+pub use buffer_pool::{BufferPool, BufferPoolStats};
 pub use clutter::ClutterStage;
 pub use doppler::DopplerStage;
 pub use range::RangeStage;
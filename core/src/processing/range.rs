@@ -2,7 +2,7 @@ use crate::math::stats::StatsHelper;
 use crate::prelude::{
     ProcessingStage, StageConfig, StageError, StageInput, StageMetadata, StageOutput, StageResult,
 };
-use crate::processing::buffer_pool::BufferPool;
+use crate::processing::buffer_pool::{BufferPool, BufferPoolStats};
 use crate::telemetry::log::LogManager;
 
 /// Range-processing stage that mirrors the legacy CPI correction / range compression.
@@ -20,6 +20,11 @@ impl RangeStage {
             logger: LogManager::new(),
         }
     }
+
+    /// Counters of this stage's buffer pool, kept across `cleanup`.
+    pub fn pool_stats(&self) -> BufferPoolStats {
+        self.pool.stats()
+    }
 }
 
 impl ProcessingStage for RangeStage {
@@ -1,4 +1,9 @@
+use crate::processing::BufferPoolStats;
+use serde::Serialize;
+use std::collections::BTreeMap;
+use std::sync::atomic::{AtomicU64, Ordering};
 use std::sync::Mutex;
+use std::time::Duration;
 
 pub struct MetricsRecorder {
     inner: Mutex<Metrics>,
@@ -45,3 +50,192 @@ impl Default for MetricsRecorder {
         Self::new()
     }
 }
+
+/// Pipeline sections timed by the workflow runner (`Range`, `Doppler` with its FFT,
+/// `Clutter` with CFAR) and by the GUI bridge (`Encode`: JSON/binary serialisation).
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum PipelineStage {
+    Range,
+    Doppler,
+    Clutter,
+    Encode,
+}
+
+impl PipelineStage {
+    pub const ALL: [PipelineStage; 4] = [
+        PipelineStage::Range,
+        PipelineStage::Doppler,
+        PipelineStage::Clutter,
+        PipelineStage::Encode,
+    ];
+
+    pub fn name(self) -> &'static str {
+        match self {
+            PipelineStage::Range => "range",
+            PipelineStage::Doppler => "doppler",
+            PipelineStage::Clutter => "clutter",
+            PipelineStage::Encode => "encode",
+        }
+    }
+}
+
+/// Lock-free accumulator for one stage's execution times.
+#[derive(Default)]
+pub struct StageTiming {
+    count: AtomicU64,
+    total_ns: AtomicU64,
+    max_ns: AtomicU64,
+    last_ns: AtomicU64,
+}
+
+/// Totals in microseconds; clients difference two snapshots for per-interval rates.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq, Serialize)]
+pub struct StageTimingSnapshot {
+    pub count: u64,
+    pub total_us: u64,
+    pub mean_us: u64,
+    pub max_us: u64,
+    pub last_us: u64,
+}
+
+impl StageTiming {
+    pub fn record(&self, elapsed: Duration) {
+        let nanos = u64::try_from(elapsed.as_nanos()).unwrap_or(u64::MAX);
+        self.count.fetch_add(1, Ordering::Relaxed);
+        self.total_ns.fetch_add(nanos, Ordering::Relaxed);
+        self.max_ns.fetch_max(nanos, Ordering::Relaxed);
+        self.last_ns.store(nanos, Ordering::Relaxed);
+    }
+
+    pub fn snapshot(&self) -> StageTimingSnapshot {
+        let count = self.count.load(Ordering::Relaxed);
+        let total_ns = self.total_ns.load(Ordering::Relaxed);
+        StageTimingSnapshot {
+            count,
+            total_us: total_ns / 1_000,
+            mean_us: if count == 0 {
+                0
+            } else {
+                total_ns / count / 1_000
+            },
+            max_us: self.max_ns.load(Ordering::Relaxed) / 1_000,
+            last_us: self.last_ns.load(Ordering::Relaxed) / 1_000,
+        }
+    }
+}
+
+/// Throughput counters shared by every clone of a runner and the bridge serving it.
+/// All updates are relaxed atomics, so recording never blocks the processing path.
+#[derive(Default)]
+pub struct PipelineMetrics {
+    stages: [StageTiming; 4],
+    processed: AtomicU64,
+    errors: AtomicU64,
+    pool_checkouts: AtomicU64,
+    pool_reused: AtomicU64,
+    pool_exhausted: AtomicU64,
+    in_flight: AtomicU64,
+    peak_in_flight: AtomicU64,
+}
+
+/// `GET /metrics` body.
+#[derive(Debug, Clone, Default, Serialize)]
+pub struct MetricsSnapshot {
+    pub processed: u64,
+    pub errors: u64,
+    pub stages: BTreeMap<&'static str, StageTimingSnapshot>,
+    pub buffer_pool: BufferPoolStats,
+    /// Payloads currently inside `Runner::execute`, and the most seen at once.
+    pub in_flight: u64,
+    pub peak_in_flight: u64,
+}
+
+/// Holds one unit of the in-flight gauge until dropped.
+pub struct InFlightGuard<'a> {
+    metrics: &'a PipelineMetrics,
+}
+
+impl Drop for InFlightGuard<'_> {
+    fn drop(&mut self) {
+        self.metrics.in_flight.fetch_sub(1, Ordering::Relaxed);
+    }
+}
+
+impl PipelineMetrics {
+    pub fn record_stage(&self, stage: PipelineStage, elapsed: Duration) {
+        self.stages[stage as usize].record(elapsed);
+    }
+
+    pub fn record_processed(&self) {
+        self.processed.fetch_add(1, Ordering::Relaxed);
+    }
+
+    pub fn record_error(&self) {
+        self.errors.fetch_add(1, Ordering::Relaxed);
+    }
+
+    pub fn add_pool_stats(&self, stats: BufferPoolStats) {
+        self.pool_checkouts
+            .fetch_add(stats.checkouts, Ordering::Relaxed);
+        self.pool_reused.fetch_add(stats.reused, Ordering::Relaxed);
+        self.pool_exhausted
+            .fetch_add(stats.exhausted, Ordering::Relaxed);
+    }
+
+    pub fn enter(&self) -> InFlightGuard<'_> {
+        let depth = self.in_flight.fetch_add(1, Ordering::Relaxed) + 1;
+        self.peak_in_flight.fetch_max(depth, Ordering::Relaxed);
+        InFlightGuard { metrics: self }
+    }
+
+    pub fn snapshot(&self) -> MetricsSnapshot {
+        MetricsSnapshot {
+            processed: self.processed.load(Ordering::Relaxed),
+            errors: self.errors.load(Ordering::Relaxed),
+            stages: PipelineStage::ALL
+                .iter()
+                .map(|&stage| (stage.name(), self.stages[stage as usize].snapshot()))
+                .collect(),
+            buffer_pool: BufferPoolStats {
+                checkouts: self.pool_checkouts.load(Ordering::Relaxed),
+                reused: self.pool_reused.load(Ordering::Relaxed),
+                exhausted: self.pool_exhausted.load(Ordering::Relaxed),
+            },
+            in_flight: self.in_flight.load(Ordering::Relaxed),
+            peak_in_flight: self.peak_in_flight.load(Ordering::Relaxed),
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn pipeline_metrics_accumulate_stage_times_and_gauge() {
+        let metrics = PipelineMetrics::default();
+        metrics.record_stage(PipelineStage::Doppler, Duration::from_micros(300));
+        metrics.record_stage(PipelineStage::Doppler, Duration::from_micros(100));
+        metrics.add_pool_stats(BufferPoolStats {
+            checkouts: 3,
+            reused: 1,
+            exhausted: 1,
+        });
+        {
+            let _outer = metrics.enter();
+            let _inner = metrics.enter();
+            assert_eq!(metrics.snapshot().in_flight, 2);
+        }
+
+        let snapshot = metrics.snapshot();
+        let doppler = snapshot.stages["doppler"];
+        assert_eq!(
+            (doppler.count, doppler.total_us, doppler.mean_us),
+            (2, 400, 200)
+        );
+        assert_eq!((doppler.max_us, doppler.last_us), (300, 100));
+        assert_eq!(snapshot.stages["range"].count, 0);
+        assert_eq!(snapshot.buffer_pool.exhausted, 1);
+        assert_eq!((snapshot.in_flight, snapshot.peak_in_flight), (0, 2));
+    }
+}
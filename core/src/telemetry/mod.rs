@@ -2,4 +2,6 @@ pub mod log;
 pub mod metrics;
 
 pub use log::LogManager;
-pub use metrics::MetricsRecorder;
+pub use metrics::{
+    MetricsRecorder, MetricsSnapshot, PipelineMetrics, PipelineStage, StageTimingSnapshot,
+};
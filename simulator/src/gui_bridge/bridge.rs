@@ -1,18 +1,47 @@
 use crate::generator::profile::{build_pri_payload_from_config, GeneratorConfig};
+use crate::gui_bridge::delta::encode_delta;
+use crate::gui_bridge::frame::{
+    encode_binary_frame, wants_binary, BINARY_CONTENT_TYPE, JSON_CONTENT_TYPE, MAX_REQUEST_ID_BYTES,
+};
 use crate::gui_bridge::model::VisualizationModel;
-use crate::workflow::runner::Runner;
+use crate::gui_bridge::workers::{QueueFull, WorkerPool};
+use crate::workflow::runner::{Runner, WorkflowResult};
 use anyhow::Result;
+use arc_swap::ArcSwap;
+use flate2::{write::GzEncoder, Compression};
 use gmticore::agp_interface::PriPayload;
+use gmticore::telemetry::{PipelineMetrics, PipelineStage};
+use serde::Deserialize;
 use serde_json::json;
 use std::{
+    convert::Infallible,
+    io::Write,
     net::SocketAddr,
-    sync::{Arc, RwLock},
+    sync::{Arc, Mutex, OnceLock, PoisonError},
     thread,
+    time::{Instant, SystemTime, UNIX_EPOCH},
 };
 use tokio::runtime::Builder;
-use warp::{http::StatusCode, Filter};
+use tokio::sync::{broadcast, oneshot};
+use tokio_stream::{wrappers::BroadcastStream, StreamExt};
+use warp::{
+    http::{header, Response, StatusCode},
+    hyper::{body::Bytes, Body},
+    Filter,
+};
+
+/// Frames buffered per streaming subscriber before a slow client starts missing updates.
+const STREAM_BACKLOG: usize = 64;
 
-fn gui_bind_address() -> SocketAddr {
+/// Full JSON payloads at least this large are gzipped for clients that accept it; smaller
+/// bodies and binary frames (packed floats) gain too little to pay for the compression.
+const GZIP_MIN_BYTES: usize = 16 * 1024;
+
+/// Processing threads unless `--workers` says otherwise; one keeps submissions serial.
+pub const DEFAULT_WORKERS: usize = 1;
+
+/// Address the bridge listens on unless `--bind` says otherwise.
+pub fn default_bind_address() -> SocketAddr {
     SocketAddr::from(([127, 0, 0, 1], 9000))
 }
 
@@ -21,109 +50,537 @@ struct WarpError;
 
 impl warp::reject::Reject for WarpError {}
 
+/// One published frame. It is immutable once swapped in, so readers never lock. The full
+/// JSON and binary bodies are encoded once by the publisher; the delta and gzip variants
+/// are encoded by the first request that needs them. Every client then gets a
+/// reference-counted handle to the same bytes.
+struct Snapshot {
+    model: Arc<VisualizationModel>,
+    /// The model this one replaced, kept so `/payload?since=` can send a delta.
+    previous: Arc<VisualizationModel>,
+    /// Newline-terminated for `/stream`; `/payload` serves it without the newline.
+    json_line: Bytes,
+    binary: Bytes,
+    delta: OnceLock<Bytes>,
+    /// `None` when the full JSON is below `GZIP_MIN_BYTES`.
+    gzip: OnceLock<Option<Bytes>>,
+}
+
+impl Snapshot {
+    fn encode(
+        model: VisualizationModel,
+        previous: Arc<VisualizationModel>,
+        metrics: &PipelineMetrics,
+    ) -> Self {
+        let started = Instant::now();
+        let json_line = encode_stream_frame(&model);
+        let binary = Bytes::from(encode_binary_frame(&model));
+        metrics.record_stage(PipelineStage::Encode, started.elapsed());
+        Self {
+            model: Arc::new(model),
+            previous,
+            json_line,
+            binary,
+            delta: OnceLock::new(),
+            gzip: OnceLock::new(),
+        }
+    }
+
+    fn empty() -> Self {
+        Self::encode(
+            VisualizationModel::default(),
+            Arc::default(),
+            &PipelineMetrics::default(),
+        )
+    }
+
+    fn sequence(&self) -> u64 {
+        self.model.sequence
+    }
+
+    fn tag(&self) -> FrameTag {
+        FrameTag::of(&self.model)
+    }
+
+    fn json(&self) -> Bytes {
+        self.json_line.slice(..self.json_line.len() - 1)
+    }
+
+    fn stream_frame(&self, binary: bool) -> Bytes {
+        if binary {
+            self.binary.clone()
+        } else {
+            self.json_line.clone()
+        }
+    }
+
+    fn delta(&self, metrics: &PipelineMetrics) -> Bytes {
+        self.delta
+            .get_or_init(|| {
+                let started = Instant::now();
+                let body = serde_json::to_vec(&encode_delta(&self.previous, &self.model))
+                    .unwrap_or_default();
+                metrics.record_stage(PipelineStage::Encode, started.elapsed());
+                Bytes::from(body)
+            })
+            .clone()
+    }
+
+    fn gzip_json(&self) -> Option<Bytes> {
+        self.gzip
+            .get_or_init(|| {
+                let json = self.json();
+                (json.len() >= GZIP_MIN_BYTES)
+                    .then(|| gzip_body(&json))
+                    .flatten()
+                    .map(Bytes::from)
+            })
+            .clone()
+    }
+}
+
+/// Query accepted by `GET /payload`; `since` takes the same `<run_id>-<sequence>` token as
+/// the ETag.
+#[derive(Debug, Default, Deserialize)]
+struct PayloadQuery {
+    since: Option<String>,
+}
+
+/// Names one published frame across bridge restarts: sequences start over with every run,
+/// so a sequence alone could match a frame of the previous run.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+struct FrameTag {
+    run_id: u64,
+    sequence: u64,
+}
+
+impl FrameTag {
+    fn of(model: &VisualizationModel) -> Self {
+        Self {
+            run_id: model.run_id,
+            sequence: model.sequence,
+        }
+    }
+
+    /// Parses `<run_id>-<sequence>`. Bare sequences from clients that predate run ids name
+    /// no run, so they never match and always get the full model.
+    fn parse(token: &str) -> Option<Self> {
+        let (run_id, sequence) = token.trim().split_once('-')?;
+        Some(Self {
+            run_id: run_id.parse().ok()?,
+            sequence: sequence.parse().ok()?,
+        })
+    }
+
+    fn etag(&self) -> String {
+        format!("\"{}-{}\"", self.run_id, self.sequence)
+    }
+}
+
+/// Latest published snapshot plus the fan-out channel feeding `GET /stream` clients.
+struct BridgeState {
+    /// Swapped atomically, so `/payload` readers never wait on publishers or each other.
+    published: ArcSwap<Snapshot>,
+    /// Held only by publishers (parallel workers), so sequence numbers and delta bases
+    /// follow publication order.
+    publish_lock: Mutex<()>,
+    frames: broadcast::Sender<Arc<Snapshot>>,
+    /// The runner's counters; the bridge adds its own encode timings.
+    metrics: Arc<PipelineMetrics>,
+    /// Runs ingested payloads off the network thread.
+    workers: WorkerPool,
+    /// Stamped on every published model; see `VisualizationModel::run_id`.
+    run_id: u64,
+}
+
+impl BridgeState {
+    fn new() -> Self {
+        Self::with_metrics(Arc::new(PipelineMetrics::default()), DEFAULT_WORKERS)
+    }
+
+    fn with_metrics(metrics: Arc<PipelineMetrics>, workers: usize) -> Self {
+        let (frames, _) = broadcast::channel(STREAM_BACKLOG);
+        Self {
+            published: ArcSwap::from_pointee(Snapshot::empty()),
+            publish_lock: Mutex::new(()),
+            frames,
+            metrics,
+            workers: WorkerPool::new(workers),
+            run_id: new_run_id(),
+        }
+    }
+
+    /// Answers `GET /metrics`: the pipeline snapshot plus bridge-side gauges.
+    fn metrics_json(&self) -> serde_json::Value {
+        let mut value = serde_json::to_value(self.metrics.snapshot()).unwrap_or_default();
+        value["sequence"] = json!(self.published.load().sequence());
+        value["stream_subscribers"] = json!(self.frames.receiver_count());
+        value["queue"] = serde_json::to_value(self.workers.stats()).unwrap_or_default();
+        value
+    }
+
+    /// Queues one execution on the worker pool. The payload is built on the worker too, and
+    /// the worker publishes the resulting model, tagged with `request_id`, so the network
+    /// thread only awaits the reply.
+    fn submit<F>(
+        self: &Arc<Self>,
+        runner: Arc<Runner>,
+        request_id: Option<String>,
+        build: F,
+    ) -> Result<oneshot::Receiver<Result<WorkflowResult>>, QueueFull>
+    where
+        F: FnOnce() -> Result<PriPayload> + Send + 'static,
+    {
+        let state = self.clone();
+        self.workers.submit(move || {
+            let result = build().and_then(|payload| runner.execute(&payload))?;
+            state.store(VisualizationModel {
+                request_id,
+                ..VisualizationModel::from_result(&result)
+            });
+            Ok(result)
+        })
+    }
+
+    /// Stamps the next sequence number, encodes and publishes the model, and pushes it to
+    /// every subscriber.
+    fn store(&self, mut model: VisualizationModel) -> u64 {
+        let publishing = self
+            .publish_lock
+            .lock()
+            .unwrap_or_else(PoisonError::into_inner);
+        let previous = self.published.load_full();
+        model.sequence = previous.sequence() + 1;
+        model.run_id = self.run_id;
+        let snapshot = Arc::new(Snapshot::encode(
+            model,
+            previous.model.clone(),
+            &self.metrics,
+        ));
+        self.published.store(snapshot.clone());
+        drop(publishing);
+
+        let sequence = snapshot.sequence();
+        // Polling-only sessions have no subscribers to hand the frame to.
+        if self.frames.receiver_count() > 0 {
+            let _ = self.frames.send(snapshot);
+        }
+        sequence
+    }
+
+    /// Answers `GET /payload`: 304 when the client already holds the current frame, a
+    /// delta when it holds the previous one, otherwise the full model. Frames are named by
+    /// run and sequence, so a client still holding a frame of an earlier run gets the full
+    /// model. Bodies are the snapshot's shared, already-encoded bytes.
+    fn payload_response(
+        &self,
+        binary: bool,
+        since: Option<FrameTag>,
+        gzip: bool,
+    ) -> Response<Body> {
+        let snapshot = self.published.load_full();
+        let etag = snapshot.tag().etag();
+        if since == Some(snapshot.tag()) {
+            return Response::builder()
+                .status(StatusCode::NOT_MODIFIED)
+                .header(header::ETAG, etag)
+                .body(Body::empty())
+                .unwrap();
+        }
+
+        // Deltas are small by construction, so only the full JSON body is worth gzipping.
+        let mut compressed = None;
+        let body = if binary {
+            snapshot.binary.clone()
+        } else if since.is_some() && since == Some(FrameTag::of(&snapshot.previous)) {
+            snapshot.delta(&self.metrics)
+        } else {
+            compressed = gzip.then(|| snapshot.gzip_json()).flatten();
+            snapshot.json()
+        };
+        let mut response = match compressed {
+            Some(compressed) => {
+                let mut response = frame_response(Body::from(compressed), binary);
+                response.headers_mut().insert(
+                    header::CONTENT_ENCODING,
+                    header::HeaderValue::from_static("gzip"),
+                );
+                response
+            }
+            None => frame_response(Body::from(body), binary),
+        };
+        if let Ok(value) = header::HeaderValue::from_str(&etag) {
+            response.headers_mut().insert(header::ETAG, value);
+        }
+        response
+    }
+}
+
+/// The bridge's start time in microseconds since the Unix epoch: distinct for every restart,
+/// and small enough that JSON clients parsing numbers as doubles keep it exact.
+fn new_run_id() -> u64 {
+    SystemTime::now()
+        .duration_since(UNIX_EPOCH)
+        .map_or(1, |elapsed| elapsed.as_micros() as u64)
+        .max(1)
+}
+
+/// The frame a client already holds, from `?since=` or an `If-None-Match` ETag.
+fn known_frame(query: &PayloadQuery, if_none_match: Option<&str>) -> Option<FrameTag> {
+    let token = match &query.since {
+        Some(since) => since.as_str(),
+        None => if_none_match?
+            .trim()
+            .trim_start_matches("W/")
+            .trim_matches('"'),
+    };
+    FrameTag::parse(token)
+}
+
+/// True when an `Accept-Encoding` header lists gzip without refusing it (`;q=0`).
+fn accepts_gzip(accept_encoding: Option<&str>) -> bool {
+    accept_encoding.map_or(false, |value| {
+        value.split(',').any(|coding| {
+            let mut parts = coding.split(';').map(str::trim);
+            parts
+                .next()
+                .map_or(false, |name| name.eq_ignore_ascii_case("gzip"))
+                && !parts.any(|param| {
+                    param
+                        .strip_prefix("q=")
+                        .and_then(|q| q.trim().parse::<f32>().ok())
+                        == Some(0.0)
+                })
+        })
+    })
+}
+
+fn gzip_body(body: &[u8]) -> Option<Vec<u8>> {
+    let mut encoder = GzEncoder::new(Vec::with_capacity(body.len() / 4), Compression::fast());
+    encoder.write_all(body).ok()?;
+    encoder.finish().ok()
+}
+
+fn frame_response(body: Body, binary: bool) -> Response<Body> {
+    let content_type = if binary {
+        BINARY_CONTENT_TYPE
+    } else {
+        JSON_CONTENT_TYPE
+    };
+    Response::builder()
+        .header(header::CONTENT_TYPE, content_type)
+        .header(header::VARY, "Accept, Accept-Encoding")
+        .body(body)
+        .unwrap()
+}
+
+/// 400 for an `X-Request-Id` too long to carry in the published frame; `None` otherwise.
+fn reject_request_id(request_id: Option<&str>) -> Option<Response<Body>> {
+    let length = request_id.map_or(0, str::len);
+    (length > MAX_REQUEST_ID_BYTES).then(|| {
+        let body = json!({
+            "status": "error",
+            "error": format!("X-Request-Id exceeds {} bytes", MAX_REQUEST_ID_BYTES),
+        });
+        Response::builder()
+            .status(StatusCode::BAD_REQUEST)
+            .header(header::CONTENT_TYPE, JSON_CONTENT_TYPE)
+            .body(Body::from(serde_json::to_vec(&body).unwrap_or_default()))
+            .unwrap()
+    })
+}
+
+/// Awaits a queued execution and builds the reply: `body` on success, tagged with the
+/// request ID; 503 when the queue was full; a rejection when processing failed.
+async fn respond<F>(
+    route: &str,
+    request_id: Option<String>,
+    pending: Result<oneshot::Receiver<Result<WorkflowResult>>, QueueFull>,
+    body: F,
+) -> Result<Response<Body>, warp::Rejection>
+where
+    F: FnOnce(&WorkflowResult) -> serde_json::Value,
+{
+    let (mut value, status) = match pending {
+        Err(QueueFull) => (json!({"status": "busy"}), StatusCode::SERVICE_UNAVAILABLE),
+        Ok(receiver) => match receiver.await {
+            Ok(Ok(result)) => (body(&result), StatusCode::OK),
+            Ok(Err(err)) => {
+                eprintln!("{} error: {}", route, err);
+                return Err(warp::reject::custom(WarpError));
+            }
+            Err(_) => {
+                eprintln!("{} error: worker exited before finishing", route);
+                return Err(warp::reject::custom(WarpError));
+            }
+        },
+    };
+    value["request_id"] = json!(request_id);
+    let mut response = Response::builder()
+        .status(status)
+        .header(header::CONTENT_TYPE, JSON_CONTENT_TYPE)
+        .body(Body::from(serde_json::to_vec(&value).unwrap_or_default()))
+        .unwrap();
+    if status == StatusCode::SERVICE_UNAVAILABLE {
+        response
+            .headers_mut()
+            .insert(header::RETRY_AFTER, header::HeaderValue::from_static("1"));
+    }
+    if let Some(value) = request_id
+        .as_deref()
+        .and_then(|id| header::HeaderValue::from_str(id).ok())
+    {
+        response.headers_mut().insert("x-request-id", value);
+    }
+    Ok(response)
+}
+
+/// Serialises one model as a newline-delimited JSON record for the streaming endpoint.
+fn encode_stream_frame(model: &VisualizationModel) -> Bytes {
+    let mut line = serde_json::to_vec(model).unwrap_or_default();
+    line.push(b'\n');
+    Bytes::from(line)
+}
+
 /// Bridge that hosts the telemetry HTTP endpoint and processes incoming payloads.
 pub struct GuiBridge {
-    state: Arc<RwLock<VisualizationModel>>,
+    state: Arc<BridgeState>,
 }
 
 impl GuiBridge {
     pub fn new(runner: Arc<Runner>) -> Self {
-        let state = Arc::new(RwLock::new(VisualizationModel::default()));
+        Self::bind(runner, default_bind_address(), DEFAULT_WORKERS)
+    }
+
+    /// Starts the bridge on `address`, so several engines can run side by side on one host.
+    /// `workers` processing threads (0: one per core) execute ingested payloads in parallel.
+    pub fn bind(runner: Arc<Runner>, address: SocketAddr, workers: usize) -> Self {
+        let state = Arc::new(BridgeState::with_metrics(runner.metrics(), workers));
         let state_for_filter = state.clone();
         let state_filter = warp::any().map(move || state_for_filter.clone());
         let runner_filter = warp::any().map(move || runner.clone());
 
         let get_route = warp::path("payload")
             .and(warp::get())
+            .and(warp::header::optional::<String>("accept"))
+            .and(warp::header::optional::<String>("if-none-match"))
+            .and(warp::header::optional::<String>("accept-encoding"))
+            .and(warp::query::<PayloadQuery>())
+            .and(state_filter.clone())
+            .map(
+                |accept: Option<String>,
+                 if_none_match: Option<String>,
+                 accept_encoding: Option<String>,
+                 query: PayloadQuery,
+                 state: Arc<BridgeState>| {
+                    let since = known_frame(&query, if_none_match.as_deref());
+                    state.payload_response(
+                        wants_binary(accept.as_deref()),
+                        since,
+                        accepts_gzip(accept_encoding.as_deref()),
+                    )
+                },
+            );
+
+        // Chunked stream: the current frame first, then every frame as it is published.
+        // JSON frames are newline-delimited; binary frames are self-delimiting via their header.
+        let stream_route = warp::path("stream")
+            .and(warp::get())
+            .and(warp::header::optional::<String>("accept"))
             .and(state_filter.clone())
-            .map(|state: Arc<RwLock<VisualizationModel>>| {
-                warp::reply::json(&*state.read().unwrap())
+            .map(|accept: Option<String>, state: Arc<BridgeState>| {
+                let binary = wants_binary(accept.as_deref());
+                let updates = BroadcastStream::new(state.frames.subscribe())
+                    .filter_map(move |frame| frame.ok().map(|frame| frame.stream_frame(binary)));
+                let frames = tokio_stream::once(state.published.load().stream_frame(binary))
+                    .chain(updates)
+                    .map(Ok::<_, Infallible>);
+                let content_type = if binary {
+                    BINARY_CONTENT_TYPE
+                } else {
+                    "application/x-ndjson"
+                };
+                Response::builder()
+                    .header(header::CONTENT_TYPE, content_type)
+                    .header(header::CACHE_CONTROL, "no-cache")
+                    .body(Body::wrap_stream(frames))
+                    .unwrap()
             });
 
+        let metrics_route = warp::path("metrics")
+            .and(warp::get())
+            .and(state_filter.clone())
+            .map(|state: Arc<BridgeState>| warp::reply::json(&state.metrics_json()));
+
+        // Both ingest routes hand their work to the pool and answer with the caller's
+        // X-Request-Id, so clients submitting in parallel can match replies to requests.
         let post_route = warp::path("ingest")
             .and(warp::post())
+            .and(warp::header::optional::<String>("x-request-id"))
             .and(warp::body::json())
             .and(state_filter.clone())
             .and(runner_filter.clone())
             .and_then(
-                |payload: PriPayload,
-                 state: Arc<RwLock<VisualizationModel>>,
+                |request_id: Option<String>,
+                 payload: PriPayload,
+                 state: Arc<BridgeState>,
                  runner: Arc<Runner>| async move {
-                    match runner.execute(&payload) {
-                        Ok(result) => {
-                            let mut guard = state.write().unwrap();
-                            *guard = VisualizationModel {
-                                power_profile: result.power_profile.clone(),
-                                detection_count: result.detection_count,
-                                detection_records: result.detection_records.clone(),
-                                detection_notes: result.doppler_notes.clone(),
-                                scenario_metadata: result.scenario_metadata.clone(),
-                            };
-                            Ok::<_, warp::Rejection>(warp::reply::with_status(
-                                warp::reply::json(&json!({"status": "ok"})),
-                                StatusCode::OK,
-                            ))
-                        }
-                        Err(err) => {
-                            eprintln!("ingest error: {}", err);
-                            Err(warp::reject::custom(WarpError))
-                        }
+                    if let Some(rejected) = reject_request_id(request_id.as_deref()) {
+                        return Ok(rejected);
                     }
+                    let pending = state.submit(runner, request_id.clone(), move || Ok(payload));
+                    respond("ingest", request_id, pending, |_| json!({"status": "ok"})).await
                 },
             );
 
         let generator_route = warp::path("ingest-config")
             .and(warp::post())
+            .and(warp::header::optional::<String>("x-request-id"))
             .and(warp::body::json())
             .and(state_filter)
             .and(runner_filter)
             .and_then(
-                |config: GeneratorConfig,
-                 state: Arc<RwLock<VisualizationModel>>,
+                |request_id: Option<String>,
+                 config: GeneratorConfig,
+                 state: Arc<BridgeState>,
                  runner: Arc<Runner>| async move {
-                    match build_pri_payload_from_config(&config)
-                        .and_then(|payload| runner.execute(&payload))
-                    {
-                        Ok(result) => {
-                            let mut guard = state.write().unwrap();
-                            *guard = VisualizationModel {
-                                power_profile: result.power_profile.clone(),
-                                detection_count: result.detection_count,
-                                detection_records: result.detection_records.clone(),
-                                detection_notes: result.doppler_notes.clone(),
-                                scenario_metadata: result.scenario_metadata.clone(),
-                            };
-                            if let Some(name) = config.scenario.as_ref() {
-                                println!(
-                                    "[GUI] Scenario {} -> detections {}",
-                                    name, result.detection_count
-                                );
-                            }
-                            Ok::<_, warp::Rejection>(warp::reply::with_status(
-                                warp::reply::json(&json!({
-                                    "status": "ok",
-                                    "detections": result.detection_count,
-                                    "description": config.description.clone().unwrap_or_default()
-                                })),
-                                StatusCode::OK,
-                            ))
-                        }
-                        Err(err) => {
-                            eprintln!("ingest-config error: {}", err);
-                            Err(warp::reject::custom(WarpError))
-                        }
+                    if let Some(rejected) = reject_request_id(request_id.as_deref()) {
+                        return Ok(rejected);
                     }
+                    let scenario = config.scenario.clone();
+                    let description = config.description.clone().unwrap_or_default();
+                    let pending = state.submit(runner, request_id.clone(), move || {
+                        build_pri_payload_from_config(&config)
+                    });
+                    respond("ingest-config", request_id, pending, |result| {
+                        if let Some(name) = scenario.as_ref() {
+                            println!(
+                                "[GUI] Scenario {} -> detections {}",
+                                name, result.detection_count
+                            );
+                        }
+                        json!({
+                            "status": "ok",
+                            "detections": result.detection_count,
+                            "description": description
+                        })
+                    })
+                    .await
                 },
             );
 
         thread::spawn(move || {
-            let routes = get_route.or(post_route).or(generator_route);
+            let routes = get_route
+                .or(stream_route)
+                .or(metrics_route)
+                .or(post_route)
+                .or(generator_route);
             let runtime = Builder::new_current_thread()
                 .enable_all()
                 .build()
                 .expect("failed to build runtime");
             runtime.block_on(async move {
-                warp::serve(routes).run(gui_bind_address()).await;
+                warp::serve(routes).run(address).await;
             });
         });
 
@@ -131,13 +588,13 @@ impl GuiBridge {
     }
 
     pub fn publish(&self, model: &VisualizationModel) -> Result<()> {
-        let mut guard = self.state.write().unwrap();
-        *guard = model.clone();
+        let sequence = self.state.store(model.clone());
         println!(
-            "[GUI] power profile points: {}, detections: {}, records: {}",
-            guard.power_profile.len(),
-            guard.detection_count,
-            guard.detection_records.len()
+            "[GUI] power profile points: {}, detections: {}, records: {}, frame: {}",
+            model.power_profile.len(),
+            model.detection_count,
+            model.detection_records.len(),
+            sequence
         );
         Ok(())
     }
@@ -148,7 +605,7 @@ impl GuiBridge {
 
     #[cfg(test)]
     pub fn snapshot(&self) -> VisualizationModel {
-        self.state.read().unwrap().clone()
+        VisualizationModel::clone(&self.state.published.load().model)
     }
 }
 
@@ -160,6 +617,14 @@ mod tests {
     use crate::workflow::runner::Runner;
     use std::sync::Arc;
 
+    fn body_bytes(response: Response<Body>) -> Bytes {
+        Builder::new_current_thread()
+            .build()
+            .unwrap()
+            .block_on(warp::hyper::body::to_bytes(response.into_body()))
+            .unwrap()
+    }
+
     #[test]
     fn gui_bridge_updates_state() {
         let cfg = WorkflowConfig::from_args(1, 8, 4);
@@ -167,14 +632,329 @@ mod tests {
         let gui = GuiBridge::new(runner.clone());
         let payload = build_pri_payload(cfg.taps, cfg.range_bins).unwrap();
         let result = runner.execute(&payload).unwrap();
-        let model = VisualizationModel {
-            power_profile: result.power_profile.clone(),
-            detection_count: result.detection_count,
-            detection_records: result.detection_records.clone(),
-            detection_notes: result.doppler_notes.clone(),
-            scenario_metadata: result.scenario_metadata.clone(),
-        };
+        let model = VisualizationModel::from_result(&result);
         gui.publish(&model).unwrap();
         assert_eq!(gui.snapshot().detection_count, result.detection_count);
     }
+
+    #[test]
+    fn bridge_state_streams_sequenced_frames() {
+        let state = BridgeState::new();
+        let mut subscriber = state.frames.subscribe();
+        state.store(VisualizationModel {
+            detection_count: 3,
+            ..Default::default()
+        });
+        state.store(VisualizationModel::default());
+
+        let first = subscriber.try_recv().unwrap();
+        assert_eq!(first.json_line.last(), Some(&b'\n'));
+        assert_eq!(&first.binary[0..4], b"GMTF");
+        let decoded: VisualizationModel = serde_json::from_slice(&first.json_line).unwrap();
+        assert_eq!(decoded.sequence, 1);
+        assert_eq!(decoded.detection_count, 3);
+        assert_ne!(decoded.run_id, 0);
+        assert_eq!(decoded.run_id, state.run_id);
+        assert_eq!(
+            u64::from_le_bytes(first.binary[32..40].try_into().unwrap()),
+            state.run_id
+        );
+        let second: VisualizationModel =
+            serde_json::from_slice(&subscriber.try_recv().unwrap().json_line).unwrap();
+        assert_eq!(second.sequence, 2);
+    }
+
+    #[test]
+    fn restarted_bridges_publish_a_new_run_id() {
+        let first = BridgeState::new();
+        first.store(VisualizationModel::default());
+        thread::sleep(std::time::Duration::from_millis(1));
+        let second = BridgeState::new();
+        second.store(VisualizationModel::default());
+        // Both runs start over at sequence 1; only the run id tells them apart.
+        assert_eq!(
+            first.published.load().sequence(),
+            second.published.load().sequence()
+        );
+        assert_ne!(first.run_id, second.run_id);
+        assert_eq!(second.published.load().model.run_id, second.run_id);
+    }
+
+    #[test]
+    fn payload_response_negotiates_not_modified_and_delta() {
+        let state = BridgeState::new();
+        state.store(VisualizationModel {
+            power_profile: vec![1.0, 2.0, 3.0, 4.0],
+            ..Default::default()
+        });
+        state.store(VisualizationModel {
+            power_profile: vec![1.0, 2.0, 3.5, 4.0],
+            ..Default::default()
+        });
+        let at = |sequence| FrameTag {
+            run_id: state.run_id,
+            sequence,
+        };
+
+        let unchanged = state.payload_response(false, Some(at(2)), false);
+        assert_eq!(unchanged.status(), StatusCode::NOT_MODIFIED);
+        assert_eq!(
+            unchanged.headers()[header::ETAG],
+            format!("\"{}-2\"", state.run_id).as_str()
+        );
+
+        let delta = state.payload_response(false, Some(at(1)), false);
+        assert_eq!(delta.status(), StatusCode::OK);
+        let delta: serde_json::Value = serde_json::from_slice(&body_bytes(delta)).unwrap();
+        assert_eq!(delta["delta"], true);
+        assert_eq!(delta["sequence"], 2);
+        assert_eq!(delta["base_sequence"], 1);
+        assert_eq!(delta["profile_changes"], json!([[2, 3.5]]));
+        assert!(delta.get("power_profile").is_none());
+
+        // A base the bridge no longer holds falls back to the full body.
+        let full = state.payload_response(false, Some(at(99)), false);
+        assert_eq!(full.status(), StatusCode::OK);
+        assert_eq!(body_bytes(full), state.published.load().json());
+
+        let query = PayloadQuery::default();
+        let tag = |run_id, sequence| Some(FrameTag { run_id, sequence });
+        assert_eq!(known_frame(&query, Some("\"7-2\"")), tag(7, 2));
+        assert_eq!(known_frame(&query, Some("W/\"7-2\"")), tag(7, 2));
+        let since = PayloadQuery {
+            since: Some("7-1".into()),
+        };
+        assert_eq!(known_frame(&since, None), tag(7, 1));
+        // Bare sequences name no run.
+        assert_eq!(known_frame(&query, Some("\"2\"")), None);
+        let bare = PayloadQuery {
+            since: Some("1".into()),
+        };
+        assert_eq!(known_frame(&bare, None), None);
+        assert_eq!(known_frame(&query, None), None);
+    }
+
+    #[test]
+    fn payload_response_sends_full_frames_to_clients_of_an_earlier_run() {
+        let old = BridgeState::new();
+        old.store(VisualizationModel::default());
+        old.store(VisualizationModel::default());
+        thread::sleep(std::time::Duration::from_millis(1));
+
+        // The restarted bridge reaches the same sequences the client last saw.
+        let restarted = BridgeState::new();
+        restarted.store(VisualizationModel {
+            power_profile: vec![1.0, 2.0],
+            ..Default::default()
+        });
+        restarted.store(VisualizationModel {
+            power_profile: vec![1.0, 3.0],
+            ..Default::default()
+        });
+        let stale = |sequence| FrameTag {
+            run_id: old.run_id,
+            sequence,
+        };
+
+        // Same sequence as the current frame: not a 304.
+        let current = restarted.payload_response(false, Some(stale(2)), false);
+        assert_eq!(current.status(), StatusCode::OK);
+        assert_eq!(body_bytes(current), restarted.published.load().json());
+        // Same sequence as the delta base: the full model, not a delta.
+        let previous = restarted.payload_response(false, Some(stale(1)), false);
+        assert_eq!(previous.status(), StatusCode::OK);
+        assert_eq!(body_bytes(previous), restarted.published.load().json());
+        let binary = restarted.payload_response(true, Some(stale(2)), false);
+        assert_eq!(binary.status(), StatusCode::OK);
+        assert_eq!(body_bytes(binary), restarted.published.load().binary);
+    }
+
+    #[test]
+    fn conditional_requests_follow_the_current_run() {
+        let old = BridgeState::new();
+        old.store(VisualizationModel::default());
+        old.store(VisualizationModel::default());
+        let old_etag = old.published.load().tag().etag();
+        thread::sleep(std::time::Duration::from_millis(1));
+
+        let restarted = BridgeState::new();
+        restarted.store(VisualizationModel {
+            power_profile: vec![1.0, 2.0],
+            ..Default::default()
+        });
+        restarted.store(VisualizationModel {
+            power_profile: vec![1.0, 3.0],
+            ..Default::default()
+        });
+        let etag = restarted.published.load().tag().etag();
+        assert_ne!(etag, old_etag);
+        let query = PayloadQuery::default();
+
+        // The old run's ETag, echoed in If-None-Match, no longer earns a 304.
+        let stale =
+            restarted.payload_response(false, known_frame(&query, Some(old_etag.as_str())), false);
+        assert_eq!(stale.status(), StatusCode::OK);
+        assert_eq!(stale.headers()[header::ETAG], etag.as_str());
+
+        // Once the client holds the new run's frames, 304 and deltas resume.
+        let unchanged =
+            restarted.payload_response(false, known_frame(&query, Some(etag.as_str())), false);
+        assert_eq!(unchanged.status(), StatusCode::NOT_MODIFIED);
+        let since = PayloadQuery {
+            since: Some(format!("{}-1", restarted.run_id)),
+        };
+        let delta = restarted.payload_response(false, known_frame(&since, None), false);
+        let delta: serde_json::Value = serde_json::from_slice(&body_bytes(delta)).unwrap();
+        assert_eq!(delta["delta"], true);
+        assert_eq!(delta["run_id"], restarted.run_id);
+        let old_since = PayloadQuery {
+            since: Some(format!("{}-1", old.run_id)),
+        };
+        let full = restarted.payload_response(false, known_frame(&old_since, None), false);
+        assert_eq!(body_bytes(full), restarted.published.load().json());
+    }
+
+    #[test]
+    fn payload_response_gzips_large_json_only() {
+        use flate2::read::GzDecoder;
+        use std::io::Read;
+
+        assert!(accepts_gzip(Some("gzip, deflate")));
+        assert!(accepts_gzip(Some("deflate, GZIP;q=0.5")));
+        assert!(!accepts_gzip(Some("gzip;q=0")));
+        assert!(!accepts_gzip(Some("deflate")));
+        assert!(!accepts_gzip(None));
+
+        let state = BridgeState::new();
+        state.store(VisualizationModel {
+            power_profile: vec![0.25; 8192],
+            ..Default::default()
+        });
+        let json = state.payload_response(false, None, true);
+        assert_eq!(json.headers()[header::CONTENT_ENCODING], "gzip");
+        let binary = state.payload_response(true, None, true);
+        assert!(binary.headers().get(header::CONTENT_ENCODING).is_none());
+        let plain = state.payload_response(false, None, false);
+        assert!(plain.headers().get(header::CONTENT_ENCODING).is_none());
+
+        let snapshot = state.published.load();
+        let mut decoded = Vec::new();
+        GzDecoder::new(snapshot.gzip_json().unwrap().as_ref())
+            .read_to_end(&mut decoded)
+            .unwrap();
+        assert_eq!(decoded, snapshot.json());
+    }
+
+    #[test]
+    fn snapshot_bodies_are_encoded_once_and_shared() {
+        let state = BridgeState::new();
+        state.store(VisualizationModel {
+            power_profile: vec![1.0, 2.0],
+            ..Default::default()
+        });
+        state.store(VisualizationModel {
+            power_profile: vec![1.0, 3.0],
+            ..Default::default()
+        });
+        let encodes = || state.metrics.snapshot().stages["encode"].count;
+        assert_eq!(encodes(), 2);
+
+        let first = state.published.load_full();
+        let second = state.published.load_full();
+        assert_eq!(first.json().as_ptr(), second.json_line.as_ptr());
+        assert_eq!(first.delta(&state.metrics), second.delta(&state.metrics));
+        assert_eq!(
+            first.delta(&state.metrics).as_ptr(),
+            second.delta(&state.metrics).as_ptr()
+        );
+        // Only the delta was encoded on demand, and only once.
+        assert_eq!(encodes(), 3);
+        assert_eq!(first.previous.sequence, 1);
+    }
+
+    #[test]
+    fn metrics_json_reports_pipeline_and_bridge_counters() {
+        let state = BridgeState::new();
+        let _subscriber = state.frames.subscribe();
+        state.store(VisualizationModel::default());
+        state.metrics.record_processed();
+
+        let metrics = state.metrics_json();
+        assert_eq!(metrics["processed"], 1);
+        assert_eq!(metrics["sequence"], 1);
+        assert_eq!(metrics["stream_subscribers"], 1);
+        assert_eq!(metrics["stages"]["encode"]["count"], 1);
+        assert_eq!(metrics["buffer_pool"]["exhausted"], 0);
+        assert_eq!(metrics["queue"]["workers"], DEFAULT_WORKERS);
+        assert_eq!(metrics["queue"]["queue_depth"], 0);
+    }
+
+    #[test]
+    fn submitted_payloads_are_executed_and_published_by_workers() {
+        let cfg = WorkflowConfig::from_args(1, 8, 4);
+        let runner = Arc::new(Runner::new(cfg.clone()));
+        let state = Arc::new(BridgeState::with_metrics(runner.metrics(), 2));
+        let pending: Vec<_> = (0..4)
+            .map(|_| {
+                state
+                    .submit(runner.clone(), None, move || {
+                        build_pri_payload(cfg.taps, cfg.range_bins)
+                    })
+                    .unwrap()
+            })
+            .collect();
+        for receiver in pending {
+            let result = receiver.blocking_recv().unwrap().unwrap();
+            assert!(result.detection_count > 0);
+        }
+        assert_eq!(state.published.load().sequence(), 4);
+        let metrics = state.metrics_json();
+        assert_eq!(metrics["processed"], 4);
+        assert_eq!(metrics["queue"]["workers"], 2);
+    }
+
+    #[test]
+    fn over_long_request_ids_are_refused() {
+        assert!(reject_request_id(None).is_none());
+        let longest = "x".repeat(MAX_REQUEST_ID_BYTES);
+        assert!(reject_request_id(Some(&longest)).is_none());
+        let rejected = reject_request_id(Some(&format!("{}x", longest))).unwrap();
+        assert_eq!(rejected.status(), StatusCode::BAD_REQUEST);
+        let body: serde_json::Value = serde_json::from_slice(&body_bytes(rejected)).unwrap();
+        assert_eq!(body["status"], "error");
+    }
+
+    #[test]
+    fn submitted_request_ids_are_published_with_their_frame() {
+        let cfg = WorkflowConfig::from_args(1, 8, 4);
+        let runner = Arc::new(Runner::new(cfg.clone()));
+        let state = Arc::new(BridgeState::with_metrics(runner.metrics(), 1));
+        let mut subscriber = state.frames.subscribe();
+        state
+            .submit(runner.clone(), Some("sweep-3-7".into()), move || {
+                build_pri_payload(cfg.taps, cfg.range_bins)
+            })
+            .unwrap()
+            .blocking_recv()
+            .unwrap()
+            .unwrap();
+
+        let frame = subscriber.try_recv().unwrap();
+        let decoded: VisualizationModel = serde_json::from_slice(&frame.json_line).unwrap();
+        assert_eq!(decoded.request_id.as_deref(), Some("sweep-3-7"));
+        assert_eq!(
+            u16::from_le_bytes(frame.binary[40..42].try_into().unwrap()),
+            9
+        );
+        assert_eq!(&frame.binary[48..57], b"sweep-3-7");
+        let delta: serde_json::Value =
+            serde_json::from_slice(&frame.delta(&state.metrics)).unwrap();
+        assert_eq!(delta["request_id"], "sweep-3-7");
+
+        // Frames published without a submission carry no id.
+        state.store(VisualizationModel::default());
+        let untagged: VisualizationModel =
+            serde_json::from_slice(&subscriber.try_recv().unwrap().json_line).unwrap();
+        assert_eq!(untagged.request_id, None);
+    }
 }
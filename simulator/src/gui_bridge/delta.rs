@@ -0,0 +1,110 @@
+use crate::gui_bridge::model::VisualizationModel;
+use serde_json::{json, Map, Value};
+
+/// Builds the `GET /payload?since=<base>` body that turns `base` into `current`.
+///
+/// Fields the client already holds are omitted: notes and scenario metadata are only
+/// sent when they changed, the profile is sent as `[index, value]` pairs unless most of
+/// it changed, and detection records are sent as the tail after `records_kept` shared ones.
+pub fn encode_delta(base: &VisualizationModel, current: &VisualizationModel) -> Value {
+    let mut body = Map::new();
+    body.insert("delta".into(), json!(true));
+    body.insert("sequence".into(), json!(current.sequence));
+    body.insert("run_id".into(), json!(current.run_id));
+    if let Some(request_id) = &current.request_id {
+        body.insert("request_id".into(), json!(request_id));
+    }
+    body.insert("base_sequence".into(), json!(base.sequence));
+    body.insert("detection_count".into(), json!(current.detection_count));
+
+    match profile_changes(&base.power_profile, &current.power_profile) {
+        Some(changes) => {
+            body.insert("profile_changes".into(), json!(changes));
+        }
+        None => {
+            body.insert("power_profile".into(), json!(current.power_profile));
+        }
+    }
+
+    if base.detection_records != current.detection_records {
+        let kept = base
+            .detection_records
+            .iter()
+            .zip(&current.detection_records)
+            .take_while(|(old, new)| old == new)
+            .count();
+        body.insert("records_kept".into(), json!(kept));
+        body.insert("detection_records".into(), json!(current.detection_records[kept..]));
+    }
+    if base.detection_notes != current.detection_notes {
+        body.insert("detection_notes".into(), json!(current.detection_notes));
+    }
+    if base.scenario_metadata != current.scenario_metadata {
+        body.insert("scenario_metadata".into(), json!(current.scenario_metadata));
+    }
+    Value::Object(body)
+}
+
+/// Sparse `(index, value)` changes, or `None` when a full profile is smaller to send.
+fn profile_changes(base: &[f32], current: &[f32]) -> Option<Vec<(usize, f32)>> {
+    if base.len() != current.len() {
+        return None;
+    }
+    let changes: Vec<(usize, f32)> = base
+        .iter()
+        .zip(current)
+        .enumerate()
+        .filter(|(_, (old, new))| old.to_bits() != new.to_bits())
+        .map(|(index, (_, new))| (index, *new))
+        .collect();
+    // A pair costs about twice a plain sample, so past half the profile it no longer pays.
+    (changes.len() * 2 <= current.len()).then_some(changes)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use gmticore::agp_interface::DetectionRecord;
+
+    fn model(
+        sequence: u64,
+        profile: Vec<f32>,
+        records: Vec<DetectionRecord>,
+    ) -> VisualizationModel {
+        VisualizationModel {
+            sequence,
+            detection_count: records.len(),
+            power_profile: profile,
+            detection_records: records,
+            detection_notes: vec!["doppler RMS 1.0".into()],
+            ..Default::default()
+        }
+    }
+
+    #[test]
+    fn delta_omits_unchanged_fields() {
+        let record = DetectionRecord::new(1.0, 100.0, 2.0, 12.0, 45.0, 0.0);
+        let base = model(4, vec![1.0, 2.0, 3.0, 4.0], vec![record.clone()]);
+        let current = model(5, vec![1.0, 2.5, 3.0, 4.0], vec![record]);
+        let delta = encode_delta(&base, &current);
+
+        assert_eq!(delta["base_sequence"], json!(4));
+        assert_eq!(delta["profile_changes"], json!([[1, 2.5]]));
+        assert!(delta.get("power_profile").is_none());
+        assert!(delta.get("detection_records").is_none());
+        assert!(delta.get("detection_notes").is_none());
+    }
+
+    #[test]
+    fn delta_sends_only_new_records_and_full_profile_when_dense() {
+        let first = DetectionRecord::new(1.0, 100.0, 2.0, 12.0, 45.0, 0.0);
+        let second = DetectionRecord::new(1.1, 220.0, -3.0, 14.0, 90.0, 0.0);
+        let base = model(1, vec![1.0, 2.0], vec![first.clone()]);
+        let current = model(2, vec![3.0, 4.0], vec![first, second]);
+        let delta = encode_delta(&base, &current);
+
+        assert_eq!(delta["power_profile"], json!([3.0, 4.0]));
+        assert_eq!(delta["records_kept"], json!(1));
+        assert_eq!(delta["detection_records"].as_array().unwrap().len(), 1);
+    }
+}
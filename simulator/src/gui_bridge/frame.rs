@@ -0,0 +1,176 @@
+use crate::gui_bridge::model::VisualizationModel;
+
+/// Media type clients send in `Accept` to receive the packed binary frame instead of JSON.
+pub const BINARY_CONTENT_TYPE: &str = "application/x-gmti-frame";
+pub const JSON_CONTENT_TYPE: &str = "application/json";
+
+/// Little-endian frame layout shared with `ui/qt/src/FrameFormat.h`.
+///
+/// ```text
+/// 0  magic "GMTF"         16 detection_count u32   28 record_stride u16
+/// 4  version u16          20 profile_len u32       30 reserved u16
+/// 6  header_bytes u16     24 record_count u32      32 run_id u64
+/// 8  sequence u64                                  40 request_id_len u16
+///                                                  42 reserved (6 bytes)
+///                                                  48 request_id, UTF-8, zero-padded to 8 bytes
+/// ```
+/// Readers skip `header_bytes`, so fields appended after the first 32 bytes (`run_id`,
+/// `request_id`) are invisible to clients that predate them. The header is followed by
+/// `profile_len` `f32` samples, zero-padded to an 8-byte boundary, then `record_count`
+/// packed detection records of `record_stride` bytes each.
+pub const FRAME_MAGIC: [u8; 4] = *b"GMTF";
+pub const FRAME_VERSION: u16 = 1;
+/// Fixed part of the header; the request id follows it.
+pub const HEADER_BYTES: usize = 48;
+pub const RECORD_BYTES: usize = 32;
+/// Longest request id a frame carries; the bridge refuses submissions with longer ones so
+/// the header length always fits its `u16`.
+pub const MAX_REQUEST_ID_BYTES: usize = 256;
+
+/// Returns true when an `Accept` header asks for the binary frame format.
+pub fn wants_binary(accept: Option<&str>) -> bool {
+    accept
+        .map(|value| value.contains(BINARY_CONTENT_TYPE))
+        .unwrap_or(false)
+}
+
+fn padded_profile_bytes(len: usize) -> usize {
+    (len * 4 + 7) & !7
+}
+
+/// The request id's bytes, cut to `MAX_REQUEST_ID_BYTES` for models built elsewhere.
+fn request_id_bytes(model: &VisualizationModel) -> &[u8] {
+    let bytes = model.request_id.as_deref().unwrap_or_default().as_bytes();
+    &bytes[..bytes.len().min(MAX_REQUEST_ID_BYTES)]
+}
+
+/// Header size including the padded request id.
+fn header_len(model: &VisualizationModel) -> usize {
+    HEADER_BYTES + ((request_id_bytes(model).len() + 7) & !7)
+}
+
+/// Total encoded size of a model, used to size the output buffer in one allocation.
+pub fn encoded_len(model: &VisualizationModel) -> usize {
+    header_len(model)
+        + padded_profile_bytes(model.power_profile.len())
+        + model.detection_records.len() * RECORD_BYTES
+}
+
+/// Packs a model into the binary frame layout described above.
+pub fn encode_binary_frame(model: &VisualizationModel) -> Vec<u8> {
+    let header_len = header_len(model);
+    let request_id = request_id_bytes(model);
+    let mut out = Vec::with_capacity(encoded_len(model));
+    out.extend_from_slice(&FRAME_MAGIC);
+    out.extend_from_slice(&FRAME_VERSION.to_le_bytes());
+    out.extend_from_slice(&(header_len as u16).to_le_bytes());
+    out.extend_from_slice(&model.sequence.to_le_bytes());
+    out.extend_from_slice(&(model.detection_count as u32).to_le_bytes());
+    out.extend_from_slice(&(model.power_profile.len() as u32).to_le_bytes());
+    out.extend_from_slice(&(model.detection_records.len() as u32).to_le_bytes());
+    out.extend_from_slice(&(RECORD_BYTES as u16).to_le_bytes());
+    out.extend_from_slice(&0u16.to_le_bytes());
+    out.extend_from_slice(&model.run_id.to_le_bytes());
+    out.extend_from_slice(&(request_id.len() as u16).to_le_bytes());
+    out.resize(HEADER_BYTES, 0);
+    out.extend_from_slice(request_id);
+    out.resize(header_len, 0);
+
+    for value in &model.power_profile {
+        out.extend_from_slice(&value.to_le_bytes());
+    }
+    out.resize(
+        header_len + padded_profile_bytes(model.power_profile.len()),
+        0,
+    );
+
+    for record in &model.detection_records {
+        out.extend_from_slice(&record.timestamp.to_le_bytes());
+        out.extend_from_slice(&record.range.to_le_bytes());
+        out.extend_from_slice(&record.doppler.to_le_bytes());
+        out.extend_from_slice(&record.snr.to_le_bytes());
+        out.extend_from_slice(&record.bearing_deg.to_le_bytes());
+        out.extend_from_slice(&record.elevation_deg.to_le_bytes());
+        out.extend_from_slice(&0u32.to_le_bytes());
+    }
+    out
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use gmticore::agp_interface::DetectionRecord;
+
+    #[test]
+    fn binary_frame_packs_header_profile_and_records() {
+        let model = VisualizationModel {
+            sequence: 7,
+            run_id: 0x1234_5678_9abc,
+            power_profile: vec![1.0, 2.0, 3.0],
+            detection_count: 1,
+            detection_records: vec![DetectionRecord::new(0.5, 1200.0, -4.0, 15.0, 90.0, 1.0)],
+            ..Default::default()
+        };
+        let frame = encode_binary_frame(&model);
+        assert_eq!(frame.len(), encoded_len(&model));
+        assert_eq!(&frame[0..4], b"GMTF");
+        assert_eq!(u16::from_le_bytes(frame[6..8].try_into().unwrap()), 48);
+        assert_eq!(u64::from_le_bytes(frame[8..16].try_into().unwrap()), 7);
+        assert_eq!(u32::from_le_bytes(frame[20..24].try_into().unwrap()), 3);
+        assert_eq!(
+            u64::from_le_bytes(frame[32..40].try_into().unwrap()),
+            0x1234_5678_9abc
+        );
+        assert_eq!(u16::from_le_bytes(frame[40..42].try_into().unwrap()), 0);
+        assert_eq!(f32::from_le_bytes(frame[52..56].try_into().unwrap()), 2.0);
+
+        let record = &frame[HEADER_BYTES + 16..];
+        assert_eq!(record.len(), RECORD_BYTES);
+        assert_eq!(f64::from_le_bytes(record[0..8].try_into().unwrap()), 0.5);
+        assert_eq!(f32::from_le_bytes(record[8..12].try_into().unwrap()), 1200.0);
+    }
+
+    #[test]
+    fn binary_frame_carries_the_request_id_in_the_header() {
+        let model = VisualizationModel {
+            request_id: Some("run-12".into()),
+            power_profile: vec![4.0],
+            ..Default::default()
+        };
+        let frame = encode_binary_frame(&model);
+        assert_eq!(frame.len(), encoded_len(&model));
+        assert_eq!(u16::from_le_bytes(frame[6..8].try_into().unwrap()), 56);
+        assert_eq!(u16::from_le_bytes(frame[40..42].try_into().unwrap()), 6);
+        assert_eq!(&frame[48..54], b"run-12");
+        assert_eq!(&frame[54..56], &[0, 0]);
+        assert_eq!(f32::from_le_bytes(frame[56..60].try_into().unwrap()), 4.0);
+    }
+
+    #[test]
+    fn over_long_request_ids_are_cut_to_fit_the_header() {
+        let model = VisualizationModel {
+            request_id: Some("x".repeat(u16::MAX as usize)),
+            power_profile: vec![4.0],
+            ..Default::default()
+        };
+        let frame = encode_binary_frame(&model);
+        let header_bytes = u16::from_le_bytes(frame[6..8].try_into().unwrap()) as usize;
+        assert_eq!(header_bytes, HEADER_BYTES + MAX_REQUEST_ID_BYTES);
+        assert_eq!(
+            u16::from_le_bytes(frame[40..42].try_into().unwrap()) as usize,
+            MAX_REQUEST_ID_BYTES
+        );
+        assert_eq!(frame.len(), encoded_len(&model));
+        assert_eq!(
+            f32::from_le_bytes(frame[header_bytes..header_bytes + 4].try_into().unwrap()),
+            4.0
+        );
+    }
+
+    #[test]
+    fn accept_header_selects_binary() {
+        assert!(wants_binary(Some("application/x-gmti-frame, application/json;q=0.5")));
+        assert!(!wants_binary(Some("application/json")));
+        assert!(!wants_binary(None));
+    }
+}
@@ -1,2 +1,5 @@
 pub mod bridge;
+pub mod delta;
+pub mod frame;
 pub mod model;
+pub mod workers;
@@ -1,9 +1,21 @@
+use crate::workflow::runner::WorkflowResult;
 use gmticore::agp_interface::{DetectionRecord, ScenarioMetadata};
 use serde::{Deserialize, Serialize};
 
 #[allow(dead_code)]
 #[derive(Debug, Clone, Serialize, Deserialize, Default)]
 pub struct VisualizationModel {
+    /// Monotonic frame counter assigned by the bridge when the model is published.
+    #[serde(default)]
+    pub sequence: u64,
+    /// Identifies the bridge run that published the frame: sequences start over whenever it
+    /// changes, so clients must not treat a lower sequence as stale. 0 before publication.
+    #[serde(default)]
+    pub run_id: u64,
+    /// `X-Request-Id` of the `/ingest` or `/ingest-config` submission that produced the
+    /// frame; omitted for untagged submissions and frames published directly.
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub request_id: Option<String>,
     pub power_profile: Vec<f32>,
     pub detection_count: usize,
     pub detection_records: Vec<DetectionRecord>,
@@ -15,6 +27,9 @@ pub struct VisualizationModel {
 impl VisualizationModel {
     pub fn new() -> Self {
         Self {
+            sequence: 0,
+            run_id: 0,
+            request_id: None,
             power_profile: Vec::new(),
             detection_count: 0,
             detection_records: Vec::new(),
@@ -22,4 +37,18 @@ impl VisualizationModel {
             scenario_metadata: None,
         }
     }
+
+    /// Builds the GUI model from a finished Range → Doppler → Clutter run.
+    pub fn from_result(result: &WorkflowResult) -> Self {
+        Self {
+            sequence: 0,
+            run_id: 0,
+            request_id: None,
+            power_profile: result.power_profile.clone(),
+            detection_count: result.detection_count,
+            detection_records: result.detection_records.clone(),
+            detection_notes: result.doppler_notes.clone(),
+            scenario_metadata: result.scenario_metadata.clone(),
+        }
+    }
 }
@@ -0,0 +1,173 @@
+use serde::Serialize;
+use std::{
+    sync::{
+        atomic::{AtomicU64, Ordering},
+        mpsc::{self, Receiver, SyncSender, TrySendError},
+        Arc, Mutex,
+    },
+    thread,
+};
+use tokio::sync::oneshot;
+
+/// Jobs each worker may have waiting behind it before submissions are refused.
+pub const QUEUE_PER_WORKER: usize = 4;
+
+type Job = Box<dyn FnOnce() + Send + 'static>;
+
+/// Returned by [`WorkerPool::submit`] when every queue slot is taken.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct QueueFull;
+
+/// Queue gauges reported by `GET /metrics`.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq, Serialize)]
+pub struct WorkerPoolStats {
+    pub workers: usize,
+    pub queue_capacity: usize,
+    /// Jobs accepted but not yet picked up by a worker.
+    pub queue_depth: u64,
+    pub rejected: u64,
+}
+
+/// Fixed set of processing threads behind a bounded queue, so CPU-bound `Runner::execute`
+/// calls run in parallel and the bridge's async runtime only ever waits on a channel.
+pub struct WorkerPool {
+    sender: SyncSender<Job>,
+    workers: usize,
+    queue_capacity: usize,
+    queued: Arc<AtomicU64>,
+    rejected: AtomicU64,
+}
+
+impl WorkerPool {
+    /// `workers == 0` starts one worker per available core.
+    pub fn new(workers: usize) -> Self {
+        let workers = if workers == 0 {
+            thread::available_parallelism().map_or(1, |count| count.get())
+        } else {
+            workers
+        };
+        let queue_capacity = workers * QUEUE_PER_WORKER;
+        let (sender, receiver) = mpsc::sync_channel::<Job>(queue_capacity);
+        let receiver = Arc::new(Mutex::new(receiver));
+        let queued = Arc::new(AtomicU64::new(0));
+        for index in 0..workers {
+            let receiver = receiver.clone();
+            let queued = queued.clone();
+            thread::Builder::new()
+                .name(format!("bridge-worker-{index}"))
+                .spawn(move || worker_loop(&receiver, &queued))
+                .expect("failed to spawn bridge worker");
+        }
+        Self {
+            sender,
+            workers,
+            queue_capacity,
+            queued,
+            rejected: AtomicU64::new(0),
+        }
+    }
+
+    /// Queues `job` without blocking; the receiver yields its result once a worker ran it.
+    pub fn submit<T, F>(&self, job: F) -> Result<oneshot::Receiver<T>, QueueFull>
+    where
+        T: Send + 'static,
+        F: FnOnce() -> T + Send + 'static,
+    {
+        let (tx, rx) = oneshot::channel();
+        let boxed: Job = Box::new(move || {
+            // The requester may have gone away; its result is simply dropped.
+            let _ = tx.send(job());
+        });
+        self.queued.fetch_add(1, Ordering::Relaxed);
+        match self.sender.try_send(boxed) {
+            Ok(()) => Ok(rx),
+            Err(TrySendError::Full(_)) | Err(TrySendError::Disconnected(_)) => {
+                self.queued.fetch_sub(1, Ordering::Relaxed);
+                self.rejected.fetch_add(1, Ordering::Relaxed);
+                Err(QueueFull)
+            }
+        }
+    }
+
+    pub fn stats(&self) -> WorkerPoolStats {
+        WorkerPoolStats {
+            workers: self.workers,
+            queue_capacity: self.queue_capacity,
+            queue_depth: self.queued.load(Ordering::Relaxed),
+            rejected: self.rejected.load(Ordering::Relaxed),
+        }
+    }
+}
+
+fn worker_loop(receiver: &Mutex<Receiver<Job>>, queued: &AtomicU64) {
+    loop {
+        // The lock is only held while waiting for the next job, never while running one.
+        let job = match receiver.lock() {
+            Ok(receiver) => receiver.recv(),
+            Err(_) => return,
+        };
+        match job {
+            Ok(job) => {
+                queued.fetch_sub(1, Ordering::Relaxed);
+                job();
+            }
+            // The pool was dropped.
+            Err(_) => return,
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::sync::Barrier;
+    use std::time::Duration;
+
+    #[test]
+    fn worker_pool_runs_jobs_in_parallel() {
+        let pool = WorkerPool::new(3);
+        // Every job waits for the other two, so this only finishes if all three run at once.
+        let barrier = Arc::new(Barrier::new(3));
+        let receivers: Vec<_> = (0..3)
+            .map(|index| {
+                let barrier = barrier.clone();
+                pool.submit(move || {
+                    barrier.wait();
+                    index * 10
+                })
+                .unwrap()
+            })
+            .collect();
+        let results: Vec<_> = receivers
+            .into_iter()
+            .map(|rx| rx.blocking_recv().unwrap())
+            .collect();
+        assert_eq!(results, vec![0, 10, 20]);
+        assert_eq!(pool.stats().workers, 3);
+    }
+
+    #[test]
+    fn worker_pool_rejects_beyond_queue_capacity() {
+        let pool = WorkerPool::new(1);
+        let (release_tx, release_rx) = mpsc::channel::<()>();
+        // One job occupies the worker, then the queue fills up behind it.
+        let first = pool.submit(move || release_rx.recv().unwrap()).unwrap();
+        while pool.stats().queue_depth > 0 {
+            thread::sleep(Duration::from_millis(1));
+        }
+        let queued: Vec<_> = (0..QUEUE_PER_WORKER)
+            .map(|_| pool.submit(|| ()).unwrap())
+            .collect();
+        assert_eq!(pool.submit(|| ()).unwrap_err(), QueueFull);
+        let stats = pool.stats();
+        assert_eq!(stats.queue_depth, QUEUE_PER_WORKER as u64);
+        assert_eq!(stats.rejected, 1);
+
+        release_tx.send(()).unwrap();
+        first.blocking_recv().unwrap();
+        for rx in queued {
+            rx.blocking_recv().unwrap();
+        }
+        assert_eq!(pool.stats().queue_depth, 0);
+    }
+}
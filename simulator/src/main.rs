@@ -5,6 +5,7 @@ use gui_bridge::bridge::GuiBridge;
 use gui_bridge::model::VisualizationModel;
 use std::fs::{self, OpenOptions};
 use std::io::Write;
+use std::net::SocketAddr;
 use std::path::PathBuf;
 use std::sync::Arc;
 use tokio::runtime::Builder as TokioBuilder;
@@ -34,6 +35,12 @@ struct Args {
     /// Keep the GUI bridge alive for incoming real-time payloads
     #[arg(long, default_value_t = false)]
     serve: bool,
+    /// Address the GUI bridge listens on; give each engine its own port to run several
+    #[arg(long, default_value_t = gui_bridge::bridge::default_bind_address())]
+    bind: SocketAddr,
+    /// Threads executing ingested payloads in parallel; 0 starts one per core
+    #[arg(long, default_value_t = gui_bridge::bridge::DEFAULT_WORKERS)]
+    workers: usize,
 }
 
 fn main() -> anyhow::Result<()> {
@@ -47,7 +54,7 @@ fn main() -> anyhow::Result<()> {
     };
 
     let runner = Runner::new(workflow_config.clone());
-    let gui_bridge = GuiBridge::new(Arc::new(runner.clone()));
+    let gui_bridge = GuiBridge::bind(Arc::new(runner.clone()), args.bind, args.workers);
     let payload = build_pri_payload(workflow_config.taps, workflow_config.range_bins)?;
 
     if args.offline {
@@ -60,13 +67,7 @@ fn main() -> anyhow::Result<()> {
             result.detection_records.len()
         );
 
-        let model = VisualizationModel {
-            power_profile: result.power_profile.clone(),
-            detection_count: result.detection_count,
-            detection_records: result.detection_records.clone(),
-            detection_notes: result.doppler_notes.clone(),
-            scenario_metadata: result.scenario_metadata.clone(),
-        };
+        let model = VisualizationModel::from_result(&result);
 
         gui_bridge.publish(&model)?;
         gui_bridge.publish_status("Offline workflow results ready.");
@@ -89,7 +90,10 @@ fn main() -> anyhow::Result<()> {
         file.write_all(report.as_bytes())?;
     }
     if args.serve {
-        gui_bridge.publish_status("HTTP bridge running (Ctrl+C to stop)...");
+        gui_bridge.publish_status(&format!(
+            "HTTP bridge running on {} (Ctrl+C to stop)...",
+            args.bind
+        ));
         let runtime = TokioBuilder::new_current_thread()
             .enable_all()
             .build()
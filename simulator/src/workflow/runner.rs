@@ -3,6 +3,9 @@ use anyhow::Context;
 use gmticore::agp_interface::{DetectionRecord, PriPayload, ScenarioMetadata};
 use gmticore::prelude::{ProcessingStage, StageInput};
 use gmticore::processing::{ClutterStage, DopplerStage, RangeStage};
+use gmticore::telemetry::{PipelineMetrics, PipelineStage};
+use std::sync::Arc;
+use std::time::Instant;
 
 pub struct WorkflowResult {
     pub power_profile: Vec<f32>,
@@ -15,16 +18,36 @@ pub struct WorkflowResult {
 #[derive(Clone)]
 pub struct Runner {
     config: WorkflowConfig,
+    // Shared by clones, so the bridge's copy reports every execution.
+    metrics: Arc<PipelineMetrics>,
 }
 
 impl Runner {
     pub fn new(config: WorkflowConfig) -> Self {
-        Self { config }
+        Self {
+            config,
+            metrics: Arc::new(PipelineMetrics::default()),
+        }
+    }
+
+    pub fn metrics(&self) -> Arc<PipelineMetrics> {
+        self.metrics.clone()
     }
 
     pub fn execute(&self, payload: &PriPayload) -> anyhow::Result<WorkflowResult> {
+        let _in_flight = self.metrics.enter();
+        let result = self.execute_stages(payload);
+        match &result {
+            Ok(_) => self.metrics.record_processed(),
+            Err(_) => self.metrics.record_error(),
+        }
+        result
+    }
+
+    fn execute_stages(&self, payload: &PriPayload) -> anyhow::Result<WorkflowResult> {
         let stage_config = self.config.to_stage_config();
 
+        let started = Instant::now();
         let mut range_stage = RangeStage::new(stage_config.range_bins.max(1));
         range_stage
             .initialize(&stage_config)
@@ -36,7 +59,11 @@ impl Runner {
             })
             .context("executing range stage")?;
         range_stage.cleanup();
+        self.metrics.add_pool_stats(range_stage.pool_stats());
+        self.metrics
+            .record_stage(PipelineStage::Range, started.elapsed());
 
+        let started = Instant::now();
         let mut doppler_stage = DopplerStage::new(stage_config.doppler_bins.max(1));
         doppler_stage
             .initialize(&stage_config)
@@ -48,7 +75,11 @@ impl Runner {
             })
             .context("executing doppler stage")?;
         doppler_stage.cleanup();
+        self.metrics.add_pool_stats(doppler_stage.pool_stats());
+        self.metrics
+            .record_stage(PipelineStage::Doppler, started.elapsed());
 
+        let started = Instant::now();
         let mut clutter_stage = ClutterStage::new(stage_config.range_bins.max(1));
         clutter_stage
             .initialize(&stage_config)
@@ -60,6 +91,9 @@ impl Runner {
             })
             .context("executing clutter stage")?;
         clutter_stage.cleanup();
+        self.metrics.add_pool_stats(clutter_stage.pool_stats());
+        self.metrics
+            .record_stage(PipelineStage::Clutter, started.elapsed());
 
         let power_profile = range_output
             .metadata
@@ -145,5 +179,13 @@ mod tests {
         assert!(result.detection_count >= 18);
         assert_eq!(result.detection_records.len(), result.detection_count);
         assert_eq!(result.power_profile.len(), cfg.range_bins);
+
+        let metrics = runner.metrics().snapshot();
+        assert_eq!(
+            (metrics.processed, metrics.errors, metrics.in_flight),
+            (1, 0, 0)
+        );
+        assert_eq!(metrics.stages["clutter"].count, 1);
+        assert!(metrics.buffer_pool.checkouts >= 3);
     }
 }
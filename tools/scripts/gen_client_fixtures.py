@@ -0,0 +1,79 @@
+"""Regenerates the recorded /payload fixtures used by gmti_visualizer_bench.
+
+Each fixture is a deterministic VisualizationModel in both wire formats:
+payload_<bins>.json (what GET /payload returns) and payload_<bins>.gmtf (the packed
+binary frame, layout in simulator/src/gui_bridge/frame.rs).
+"""
+
+import argparse
+import json
+import math
+import random
+import struct
+from pathlib import Path
+
+BIN_COUNTS = (256, 2048, 8192)
+HEADER = struct.Struct("<4sHHQIIIHH")
+RECORD = struct.Struct("<dfffffI")
+
+
+def build_model(bins: int, seed: int) -> dict:
+    rng = random.Random(seed + bins)
+    profile = []
+    for i in range(bins):
+        value = 0.02 + 0.01 * rng.random() + 0.05 * (1.0 + math.sin(i * 2.0 * math.pi * 32.0 / bins))
+        profile.append(round(value, 6))
+    records = []
+    for i in range(max(4, bins // 64)):
+        peak = rng.randrange(bins)
+        profile[peak] = round(1.0 + 4.0 * rng.random(), 6)
+        records.append(
+            {
+                "timestamp": round(i * 0.001, 6),
+                "range": round(peak * 10000.0 / bins, 3),
+                "doppler": round(rng.uniform(-40.0, 40.0), 3),
+                "snr": round(rng.uniform(8.0, 30.0), 3),
+                "bearing_deg": round(rng.uniform(0.0, 360.0), 3),
+                "elevation_deg": round(rng.uniform(-5.0, 15.0), 3),
+            }
+        )
+    return {
+        "sequence": 1,
+        "power_profile": profile,
+        "detection_count": len(records),
+        "detection_records": records,
+        "detection_notes": [f"fixture {bins} bins", "CFAR threshold 13.0 dB"],
+        "scenario_metadata": None,
+    }
+
+
+def encode_binary(model: dict) -> bytes:
+    profile = model["power_profile"]
+    records = model["detection_records"]
+    out = bytearray(
+        HEADER.pack(b"GMTF", 1, HEADER.size, model["sequence"], model["detection_count"],
+                    len(profile), len(records), RECORD.size, 0)
+    )
+    out += struct.pack(f"<{len(profile)}f", *profile)
+    out += b"\0" * (-len(out) % 8)
+    for r in records:
+        out += RECORD.pack(r["timestamp"], r["range"], r["doppler"], r["snr"], r["bearing_deg"],
+                           r["elevation_deg"], 0)
+    return bytes(out)
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--out", type=Path, default=Path(__file__).resolve().parents[1] / "data")
+    parser.add_argument("--seed", type=int, default=1337)
+    args = parser.parse_args()
+
+    for bins in BIN_COUNTS:
+        model = build_model(bins, args.seed)
+        (args.out / f"payload_{bins}.json").write_text(json.dumps(model, separators=(",", ":")) + "\n")
+        (args.out / f"payload_{bins}.gmtf").write_bytes(encode_binary(model))
+        print(f"wrote payload_{bins}.json / payload_{bins}.gmtf")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,54 @@
+"""Writes a synthetic PRI capture for the Qt client's "Ingest capture" mode.
+
+A capture is newline-delimited JSON with one PriPayload per line (the body POST /ingest
+accepts, see core/src/agp_interface/pri.rs). Real captures converted from recorded
+waveforms use the same framing.
+"""
+
+import argparse
+import json
+import math
+import random
+from pathlib import Path
+
+
+def build_frame(index: int, taps: int, range_bins: int, rng: random.Random) -> dict:
+    samples = []
+    for tap in range(taps):
+        for r in range(range_bins):
+            x = r / range_bins
+            value = math.sin((x + index * 0.001 + tap * 0.0025) * 2.0 * math.pi * 32.0) * (0.2 + 0.8 * (1.0 - x))
+            samples.append(round(value + rng.uniform(-0.03, 0.03), 5))
+    return {
+        "samples": samples,
+        "ancillary": {
+            "timestamp": round(index * 0.05, 3),
+            "mode": "AdvGmtiScan",
+            "pulse_count": taps,
+            "dwell": 45.0,
+            "range_start": 0.0,
+            "range_end": 30000.0,
+        },
+    }
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--out", type=Path,
+                        default=Path(__file__).resolve().parents[1] / "data" / "sample_pri.ndjson")
+    parser.add_argument("--frames", type=int, default=64)
+    parser.add_argument("--taps", type=int, default=4)
+    parser.add_argument("--range-bins", type=int, default=1024)
+    parser.add_argument("--seed", type=int, default=1337)
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    with args.out.open("w") as out:
+        for index in range(args.frames):
+            out.write(json.dumps(build_frame(index, args.taps, args.range_bins, rng), separators=(",", ":")))
+            out.write("\n")
+    print(f"wrote {args.frames} frames to {args.out}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,445 @@
+#include "DetectionStore.h"
+#include "FrameDecoder.h"
+#include "ProfileKernels.h"
+#include "ScenarioFile.h"
+#include "StatusGraph.h"
+#include "WaterfallView.h"
+
+#include <QApplication>
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QRandomGenerator>
+#include <QtTest>
+#include <cstring>
+#include <limits>
+
+// Run headless with e.g. `gmti_visualizer_bench -median 5` or `-tickcounter`; fixtures
+// are the recorded payloads in tools/data.
+class ClientBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void decodePayload_data();
+    void decodePayload();
+    void decodeRestartedSequence_data();
+    void decodeRestartedSequence();
+    void decodeRejectedDelta_data();
+    void decodeRejectedDelta();
+    void decodeRequestId_data();
+    void decodeRequestId();
+    void paintStatusGraph_data();
+    void paintStatusGraph();
+    void repaintStatusGraph_data();
+    void repaintStatusGraph();
+    void updateWaterfall_data();
+    void updateWaterfall();
+    void loadScenarios();
+    void queryDetections_data();
+    void queryDetections();
+    void profileKernels_data();
+    void profileKernels();
+    void profileKernelsSkipNaN_data();
+    void profileKernelsSkipNaN();
+
+private:
+    static QByteArray fixture(int bins, bool binary);
+    static FrameSnapshot decodedFixture(int bins);
+};
+
+namespace
+{
+const int kBinCounts[] = {256, 2048, 8192};
+const QSize kWidgetSizes[] = {QSize(400, 200), QSize(1280, 400), QSize(3840, 800)};
+} // namespace
+
+QByteArray ClientBench::fixture(int bins, bool binary)
+{
+    QFile file(QDir(QStringLiteral(GMTI_SOURCE_ROOT "/tools/data"))
+                   .filePath(QStringLiteral("payload_%1.%2").arg(bins).arg(binary ? "gmtf" : "json")));
+    if (!file.open(QIODevice::ReadOnly)) {
+        qFatal("missing fixture %s; run tools/scripts/gen_client_fixtures.py", qPrintable(file.fileName()));
+    }
+    return file.readAll();
+}
+
+FrameSnapshot ClientBench::decodedFixture(int bins)
+{
+    FrameSnapshot frame;
+    FrameDecoder decoder;
+    QObject::connect(&decoder, &FrameDecoder::frameDecoded, [&frame](const FrameSnapshot& decoded) { frame = decoded; });
+    decoder.decodePayload(fixture(bins, true), true, 0, 0);
+    return frame;
+}
+
+void ClientBench::decodePayload_data()
+{
+    QTest::addColumn<QByteArray>("body");
+    QTest::addColumn<bool>("binary");
+    for (int bins : kBinCounts) {
+        QTest::addRow("json/%d", bins) << fixture(bins, false) << false;
+        QTest::addRow("binary/%d", bins) << fixture(bins, true) << true;
+    }
+}
+
+void ClientBench::decodePayload()
+{
+    QFETCH(QByteArray, body);
+    QFETCH(bool, binary);
+    int decoded = 0;
+    FrameDecoder decoder;
+    QObject::connect(&decoder, &FrameDecoder::frameDecoded, [&decoded](const FrameSnapshot&) { ++decoded; });
+    QBENCHMARK {
+        // Reset per pass, otherwise the repeated sequence is dropped unpublished; the
+        // decoder's FramePool stays warm, as it does between frames of a live session.
+        decoder.reset();
+        decoder.decodePayload(body, binary, 0, 0);
+    }
+    QVERIFY(decoded > 0);
+}
+
+void ClientBench::decodeRestartedSequence_data()
+{
+    // Each frame is "sequence" or "sequence@run"; `published` lists the sequences that reach
+    // the widgets and `dropped` the frames counted as lost.
+    QTest::addColumn<QStringList>("frames");
+    QTest::addColumn<QList<int>>("published");
+    QTest::addColumn<int>("dropped");
+    QTest::addRow("stale reply") << QStringList{"500", "498", "501"} << QList<int>{500, 501} << 1;
+    QTest::addRow("restart without run id") << QStringList{"500", "3", "4"} << QList<int>{500, 3, 4} << 0;
+    QTest::addRow("restart from 1") << QStringList{"40", "1", "2"} << QList<int>{40, 1, 2} << 0;
+    QTest::addRow("new run id") << QStringList{"500@7", "3@9", "498@9"} << QList<int>{500, 3, 498} << 494;
+    QTest::addRow("new run, same sequence") << QStringList{"12@7", "12@9", "12@9"} << QList<int>{12, 12} << 0;
+}
+
+void ClientBench::decodeRestartedSequence()
+{
+    QFETCH(QStringList, frames);
+    QFETCH(QList<int>, published);
+    QFETCH(int, dropped);
+    FrameDecoder decoder;
+    QList<int> sequences;
+    quint64 lost = 0;
+    QObject::connect(&decoder, &FrameDecoder::frameDecoded,
+                     [&sequences](const FrameSnapshot& frame) { sequences.append(static_cast<int>(frame.sequence)); });
+    QObject::connect(&decoder, &FrameDecoder::framesDropped, [&lost](quint64 count) { lost += count; });
+    for (const QString& frame : frames) {
+        const QStringList fields = frame.split(QLatin1Char('@'));
+        const QString run = fields.size() > 1 ? QStringLiteral(",\"run_id\":%1").arg(fields.at(1)) : QString();
+        const QString body = QStringLiteral("{\"sequence\":%1%2,\"power_profile\":[1.0]}").arg(fields.at(0), run);
+        decoder.decodePayload(body.toUtf8(), false, 0, 0);
+    }
+    QCOMPARE(sequences, published);
+    QCOMPARE(lost, static_cast<quint64>(dropped));
+}
+
+void ClientBench::decodeRejectedDelta_data()
+{
+    QTest::addColumn<QByteArray>("delta");
+    QTest::addColumn<bool>("applied");
+    QTest::addRow("same run") << QByteArray(R"({"delta":true,"sequence":2,"run_id":7,"base_sequence":1})") << true;
+    QTest::addRow("other run") << QByteArray(R"({"delta":true,"sequence":2,"run_id":9,"base_sequence":1})") << false;
+    QTest::addRow("other base") << QByteArray(R"({"delta":true,"sequence":3,"run_id":7,"base_sequence":2})") << false;
+}
+
+void ClientBench::decodeRejectedDelta()
+{
+    QFETCH(QByteArray, delta);
+    QFETCH(bool, applied);
+    FrameDecoder decoder;
+    int published = 0;
+    int resyncs = 0;
+    QObject::connect(&decoder, &FrameDecoder::frameDecoded, [&published](const FrameSnapshot&) { ++published; });
+    QObject::connect(&decoder, &FrameDecoder::resyncRequired, [&resyncs]() { ++resyncs; });
+    decoder.decodePayload(R"({"sequence":1,"run_id":7,"power_profile":[1.0]})", false, 0, 0);
+    decoder.decodePayload(delta, false, 0, 0);
+    QCOMPARE(published, applied ? 2 : 1);
+    QCOMPARE(resyncs, applied ? 0 : 1);
+}
+
+void ClientBench::decodeRequestId_data()
+{
+    QTest::addColumn<QByteArray>("body");
+    QTest::addColumn<bool>("binary");
+    QTest::addColumn<QString>("requestId");
+    QTest::addRow("json") << QByteArray(R"({"sequence":4,"request_id":"sweep-3-7","power_profile":[1.0]})") << false
+                          << QStringLiteral("sweep-3-7");
+    QTest::addRow("json untagged") << QByteArray(R"({"sequence":4,"power_profile":[1.0]})") << false << QString();
+
+    // Header with run id and a 9-byte request id padded to 16, then one sample.
+    const QByteArray id("sweep-3-7");
+    FrameFormat::Header header{FrameFormat::kMagic, FrameFormat::kVersion, 64, 4, 0, 1, 0,
+                               sizeof(FrameFormat::DetectionRecord), 0};
+    QByteArray frame(64 + 8, '\0');
+    std::memcpy(frame.data(), &header, sizeof(header));
+    const quint16 length = id.size();
+    std::memcpy(frame.data() + FrameFormat::kRequestIdLengthOffset, &length, sizeof(length));
+    std::memcpy(frame.data() + FrameFormat::kRequestIdOffset, id.constData(), id.size());
+    QTest::addRow("binary") << frame << true << QString::fromUtf8(id);
+    // A length running past header_bytes is ignored rather than read out of bounds.
+    const quint16 overlong = 17;
+    std::memcpy(frame.data() + FrameFormat::kRequestIdLengthOffset, &overlong, sizeof(overlong));
+    QTest::addRow("binary overlong") << frame << true << QString();
+}
+
+void ClientBench::decodeRequestId()
+{
+    QFETCH(QByteArray, body);
+    QFETCH(bool, binary);
+    QFETCH(QString, requestId);
+    FrameDecoder decoder;
+    FrameSnapshot frame;
+    QObject::connect(&decoder, &FrameDecoder::frameDecoded, [&frame](const FrameSnapshot& decoded) { frame = decoded; });
+    decoder.decodePayload(body, binary, 0, 0);
+    QCOMPARE(frame.sequence, static_cast<quint64>(4));
+    QCOMPARE(frame.request_id, requestId);
+}
+
+void ClientBench::paintStatusGraph_data()
+{
+    QTest::addColumn<int>("bins");
+    QTest::addColumn<QSize>("size");
+    for (int bins : kBinCounts) {
+        for (const QSize& size : kWidgetSizes) {
+            QTest::addRow("%d/%dx%d", bins, size.width(), size.height()) << bins << size;
+        }
+    }
+}
+
+void ClientBench::paintStatusGraph()
+{
+    QFETCH(int, bins);
+    QFETCH(QSize, size);
+    const FrameSnapshot frame = decodedFixture(bins);
+    StatusGraph graph;
+    graph.resize(size);
+    QImage target(size, QImage::Format_ARGB32_Premultiplied);
+    // A new frame every pass: decimation, trace and frame pixmap are all rebuilt.
+    QBENCHMARK {
+        graph.updateData(frame);
+        graph.render(&target);
+    }
+}
+
+void ClientBench::repaintStatusGraph_data()
+{
+    paintStatusGraph_data();
+}
+
+void ClientBench::repaintStatusGraph()
+{
+    QFETCH(int, bins);
+    QFETCH(QSize, size);
+    StatusGraph graph;
+    graph.resize(size);
+    graph.updateData(decodedFixture(bins));
+    QImage target(size, QImage::Format_ARGB32_Premultiplied);
+    graph.render(&target);
+    // Expose-only repaint: should be a single cached blit.
+    QBENCHMARK {
+        graph.render(&target);
+    }
+}
+
+void ClientBench::updateWaterfall_data()
+{
+    QTest::addColumn<int>("bins");
+    for (int bins : kBinCounts) {
+        QTest::addRow("%d", bins) << bins;
+    }
+}
+
+void ClientBench::updateWaterfall()
+{
+    QFETCH(int, bins);
+    const FrameSnapshot frame = decodedFixture(bins);
+    WaterfallView waterfall(512);
+    waterfall.resize(1280, 512);
+    QBENCHMARK {
+        waterfall.updateData(frame);
+    }
+}
+
+void ClientBench::loadScenarios()
+{
+    const QDir dir(QStringLiteral(GMTI_SOURCE_ROOT "/simulator/configs"));
+    const auto files = dir.entryInfoList(QStringList{QStringLiteral("*.yaml")}, QDir::Files);
+    QVERIFY(!files.isEmpty());
+    int loaded = 0;
+    QBENCHMARK {
+        for (const auto& file : files) {
+            Scenario scenario;
+            loaded += ScenarioFile::load(file.absoluteFilePath(), Scenario(), &scenario) ? 1 : 0;
+        }
+    }
+    QVERIFY(loaded > 0);
+}
+
+void ClientBench::queryDetections_data()
+{
+    QTest::addColumn<int>("rows");
+    QTest::addColumn<double>("window");
+    QTest::addColumn<double>("minSnr");
+    // An hour at ~280 detections/s, queried for the last minute and for strong returns.
+    for (int rows : {100000, 1000000}) {
+        QTest::addRow("%d rows, 60 s", rows) << rows << 60.0 << 0.0;
+        QTest::addRow("%d rows, 60 s, 20 dB", rows) << rows << 60.0 << 20.0;
+        QTest::addRow("%d rows, 10 km box", rows) << rows << 0.0 << 0.0;
+    }
+}
+
+void ClientBench::queryDetections()
+{
+    QFETCH(int, rows);
+    QFETCH(double, window);
+    QFETCH(double, minSnr);
+    DetectionStore store(qint64(256) << 20);
+    QRandomGenerator random(7);
+    QVector<FrameFormat::DetectionRecord> frame(64);
+    double time = 0.0;
+    for (int appended = 0; appended < rows; appended += frame.size()) {
+        for (auto& record : frame) {
+            record = {time, static_cast<float>(random.bounded(10000.0)), 0.0f, static_cast<float>(random.bounded(30.0)),
+                      static_cast<float>(random.bounded(360.0)), 0.0f, 0};
+            time += 1.0 / 280.0;
+        }
+        store.append(frame);
+    }
+
+    DetectionStore::Filter filter = store.windowFilter(window);
+    if (minSnr > 0.0) {
+        filter.min_snr = static_cast<float>(minSnr);
+    }
+    const QRectF box(-5000.0, -5000.0, 10000.0, 10000.0);
+    int matched = 0;
+    QBENCHMARK {
+        matched = 0;
+        if (window > 0.0) {
+            store.forEachMatching(filter, [&matched](int) { ++matched; });
+        } else {
+            store.forEachIn(box, [&matched](int) { ++matched; }, filter);
+        }
+    }
+    QVERIFY(matched > 0);
+}
+
+void ClientBench::profileKernels_data()
+{
+    QTest::addColumn<QString>("kernel");
+    // One 8192-bin channel per iteration; GMTI_SIMD=scalar|sse2 compares against narrower sets.
+    for (const char* kernel : {"max", "column min/max", "scale", "decibels", "colour map", "screen points"}) {
+        QTest::addRow("%s", kernel) << QString::fromLatin1(kernel);
+    }
+}
+
+void ClientBench::profileKernels()
+{
+    QFETCH(QString, kernel);
+    constexpr int kBins = 8192;
+    constexpr int kColumns = 1280;
+    QRandomGenerator random(11);
+    QVector<float> profile(kBins);
+    for (float& value : profile) {
+        value = static_cast<float>(random.bounded(1000.0));
+    }
+    QVector<float> levels(kBins);
+    QVector<QRgb> palette(256);
+    QVector<QRgb> colours(kBins);
+    QVector<QPointF> points(kBins);
+    qInfo("kernels: %s", ProfileKernels::isa());
+
+    float peak = 0.0f;
+    QBENCHMARK {
+        if (kernel == QLatin1String("max")) {
+            peak = ProfileKernels::maxValue(profile.constData(), kBins);
+        } else if (kernel == QLatin1String("column min/max")) {
+            ProfileKernels::columnMinMax(profile.constData(), kBins, kColumns, 1e-3f, levels.data());
+        } else if (kernel == QLatin1String("scale")) {
+            ProfileKernels::scale(profile.constData(), kBins, 1e-3f, levels.data());
+        } else if (kernel == QLatin1String("decibels")) {
+            ProfileKernels::toDecibels(profile.constData(), kBins, levels.data());
+        } else if (kernel == QLatin1String("colour map")) {
+            ProfileKernels::colourMap(profile.constData(), kBins, 0.0f, 0.255f, palette.constData(), colours.data());
+        } else {
+            ProfileKernels::toScreen(profile.constData(), kBins, 1, 0.0, 0.1, 400.0, 0.4, points.data());
+        }
+    }
+    QVERIFY(kernel != QLatin1String("max") || peak > 0.0f);
+}
+
+void ClientBench::profileKernelsSkipNaN_data()
+{
+    QTest::addColumn<int>("samples");
+    QTest::addColumn<QList<int>>("nans");
+    // Odd lengths leave tails after the vector loops; NaNs sit in the first vector, the
+    // middle and the tail. Run once per GMTI_SIMD set to compare each with the scalar one.
+    for (int samples : {1, 7, 8, 9, 17, 33, 255}) {
+        QTest::addRow("%d, none", samples) << samples << QList<int>{};
+        QTest::addRow("%d, first lanes", samples) << samples << QList<int>{0, 1 % samples, 2 % samples, 5 % samples};
+        QTest::addRow("%d, middle and tail", samples) << samples << QList<int>{samples / 2, samples - 1};
+        QTest::addRow("%d, all", samples) << samples << QList<int>{-1};
+    }
+}
+
+void ClientBench::profileKernelsSkipNaN()
+{
+    QFETCH(int, samples);
+    QFETCH(QList<int>, nans);
+    constexpr float kInf = std::numeric_limits<float>::infinity();
+    QRandomGenerator random(13);
+    QVector<float> profile(samples);
+    for (float& value : profile) {
+        value = static_cast<float>(random.bounded(5.0));
+    }
+    for (int index : nans) {
+        if (index < 0) {
+            profile.fill(std::numeric_limits<float>::quiet_NaN());
+        } else {
+            profile[index] = std::numeric_limits<float>::quiet_NaN();
+        }
+    }
+    // Bitwise equality, since the reference's infinities and the kernels' must match too.
+    const auto same = [](float a, float b) { return std::memcmp(&a, &b, sizeof(float)) == 0; };
+    const auto spanMax = [&profile](int begin, int end) {
+        float high = -kInf;
+        for (int i = begin; i < end; ++i) {
+            high = profile[i] > high ? profile[i] : high;
+        }
+        return high;
+    };
+    QVERIFY(same(ProfileKernels::maxValue(profile.constData(), samples), spanMax(0, samples)));
+
+    for (int columns : {1, (samples + 2) / 3, samples}) {
+        QVector<float> levels(2 * columns);
+        QVector<float> peaks(columns);
+        ProfileKernels::columnMinMax(profile.constData(), samples, columns, 0.5f, levels.data());
+        ProfileKernels::columnMax(profile.constData(), samples, columns, peaks.data());
+        for (int column = 0; column < columns; ++column) {
+            const int begin = static_cast<int>(static_cast<qint64>(column) * samples / columns);
+            const int end = qMax(begin + 1, static_cast<int>(static_cast<qint64>(column + 1) * samples / columns));
+            float low = kInf;
+            for (int i = begin; i < end; ++i) {
+                low = profile[i] < low ? profile[i] : low;
+            }
+            QVERIFY2(same(levels[2 * column], low * 0.5f), qPrintable(QStringLiteral("column %1 min").arg(column)));
+            QVERIFY2(same(levels[2 * column + 1], spanMax(begin, end) * 0.5f),
+                     qPrintable(QStringLiteral("column %1 max").arg(column)));
+            QVERIFY2(same(peaks[column], spanMax(begin, end)),
+                     qPrintable(QStringLiteral("column %1 peak").arg(column)));
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    // The widgets are only ever rendered into images, so no display is needed.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    ClientBench bench;
+    return QTest::qExec(&bench, argc, argv);
+}
+
+#include "ClientBench.moc"
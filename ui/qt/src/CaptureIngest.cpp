@@ -0,0 +1,210 @@
+#include "CaptureIngest.h"
+
+#include "EndpointPool.h"
+
+#include <QBuffer>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+
+#include <cstring>
+#include <utility>
+
+namespace
+{
+// Same ceiling as SweepRunner: Qt opens at most six HTTP/1.1 connections per host.
+constexpr int kMaxParallelRequests = 6;
+constexpr int kRequestTimeoutMs = 30000;
+constexpr int kReportIntervalMs = 250;
+// Finest pacing step; faster rates send several frames per tick.
+constexpr int kPaceIntervalMs = 5;
+
+bool isBlankLine(const uchar* begin, const uchar* end)
+{
+    for (; begin < end; ++begin) {
+        if (*begin != ' ' && *begin != '\t' && *begin != '\r') {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+CaptureIngest::CaptureIngest(EndpointPool* network, const QUrl& endpoint, QObject* parent)
+    : QObject(parent)
+    , network_(network)
+    , endpoint_(endpoint)
+{
+    pace_timer_.setTimerType(Qt::PreciseTimer);
+    pace_timer_.setInterval(kPaceIntervalMs);
+    connect(&pace_timer_, &QTimer::timeout, this, &CaptureIngest::pump);
+    report_timer_.setInterval(kReportIntervalMs);
+    connect(&report_timer_, &QTimer::timeout, this, [this]() {
+        updateRate();
+        emit statisticsChanged(stats_);
+    });
+}
+
+CaptureIngest::~CaptureIngest()
+{
+    // Uploads read straight from the mapping, so they must end before it is unmapped.
+    for (QNetworkReply* reply : std::exchange(replies_, {})) {
+        reply->disconnect(this);
+        reply->abort();
+        reply->deleteLater();
+    }
+}
+
+bool CaptureIngest::open(const QString& path, QString* error)
+{
+    stop();
+    frames_.clear();
+    if (file_.isOpen()) {
+        file_.close();
+        map_ = nullptr;
+    }
+
+    file_.setFileName(path);
+    if (!file_.open(QIODevice::ReadOnly)) {
+        *error = file_.errorString();
+        return false;
+    }
+    const qint64 size = file_.size();
+    map_ = size > 0 ? file_.map(0, size) : nullptr;
+    if (!map_) {
+        *error = size > 0 ? file_.errorString() : tr("capture is empty");
+        file_.close();
+        return false;
+    }
+
+    // One frame per non-blank line; memchr keeps indexing at memory bandwidth.
+    const uchar* cursor = map_;
+    const uchar* const end = map_ + size;
+    while (cursor < end) {
+        const auto* eol = static_cast<const uchar*>(std::memchr(cursor, '\n', end - cursor));
+        const uchar* lineEnd = eol ? eol : end;
+        if (!isBlankLine(cursor, lineEnd)) {
+            frames_.append({cursor - map_, lineEnd - cursor});
+        }
+        cursor = lineEnd + 1;
+    }
+    if (frames_.isEmpty()) {
+        *error = tr("capture has no frames");
+        file_.close();
+        map_ = nullptr;
+        return false;
+    }
+    stats_ = Statistics();
+    stats_.frames = frames_.size();
+    return true;
+}
+
+void CaptureIngest::setMaxInFlight(int count)
+{
+    max_in_flight_ = qBound(1, count, kMaxParallelRequests);
+}
+
+void CaptureIngest::start()
+{
+    if (running_ || frames_.isEmpty()) {
+        return;
+    }
+    running_ = true;
+    next_ = 0;
+    const int frames = stats_.frames;
+    stats_ = Statistics();
+    stats_.frames = frames;
+    window_acknowledged_ = 0;
+    window_start_ms_ = 0;
+    clock_.start();
+    pace_timer_.start();
+    report_timer_.start();
+    pump();
+}
+
+void CaptureIngest::stop()
+{
+    if (!running_) {
+        return;
+    }
+    for (QNetworkReply* reply : std::exchange(replies_, {})) {
+        reply->disconnect(this);
+        reply->abort();
+        reply->deleteLater();
+    }
+    finish();
+}
+
+void CaptureIngest::pump()
+{
+    if (!running_) {
+        return;
+    }
+    const bool capped = !loop_;
+    while (replies_.size() < max_in_flight_ && (!capped || next_ < frames_.size())) {
+        // Frame n is due n / rate seconds after start; late frames go out back to back.
+        if (rate_fps_ > 0.0 && next_ * 1000.0 / rate_fps_ > clock_.elapsed()) {
+            break;
+        }
+        send(static_cast<int>(next_ % frames_.size()));
+        ++next_;
+    }
+    if (capped && next_ >= frames_.size() && replies_.isEmpty()) {
+        finish();
+    }
+}
+
+void CaptureIngest::send(int index)
+{
+    const Frame& frame = frames_[index];
+    // fromRawData shares the mapping; QNetworkAccessManager reads a QBuffer's bytes in place.
+    auto* body = new QBuffer(this);
+    body->setData(QByteArray::fromRawData(reinterpret_cast<const char*>(map_ + frame.offset),
+                                          static_cast<int>(frame.size)));
+    body->open(QIODevice::ReadOnly);
+
+    QNetworkRequest request = network_->request(endpoint_, kRequestTimeoutMs);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("application/json"));
+    request.setHeader(QNetworkRequest::ContentLengthHeader, frame.size);
+    QNetworkReply* reply = network_->post(request, body);
+    body->setParent(reply);
+    replies_.append(reply);
+    ++stats_.sent;
+    stats_.bytes += frame.size;
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() { onReplyFinished(reply); });
+}
+
+void CaptureIngest::onReplyFinished(QNetworkReply* reply)
+{
+    reply->deleteLater();
+    replies_.removeOne(reply);
+    if (reply->error() == QNetworkReply::NoError) {
+        ++stats_.acknowledged;
+    } else {
+        ++stats_.failed;
+    }
+    pump();
+}
+
+void CaptureIngest::updateRate()
+{
+    const qint64 now = clock_.elapsed();
+    if (now - window_start_ms_ >= 1000) {
+        stats_.fps = (stats_.acknowledged - window_acknowledged_) * 1000.0 / (now - window_start_ms_);
+        window_acknowledged_ = stats_.acknowledged;
+        window_start_ms_ = now;
+    }
+}
+
+void CaptureIngest::finish()
+{
+    running_ = false;
+    pace_timer_.stop();
+    report_timer_.stop();
+    const qint64 elapsed = clock_.elapsed();
+    // The closing report gives the whole run's average rather than the last window.
+    if (elapsed > 0) {
+        stats_.fps = stats_.acknowledged * 1000.0 / elapsed;
+    }
+    emit statisticsChanged(stats_);
+    emit finished();
+}
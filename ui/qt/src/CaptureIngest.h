@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QObject>
+#include <QTimer>
+#include <QUrl>
+#include <QVector>
+
+class EndpointPool;
+class QNetworkReply;
+
+// Streams a PRI capture to POST /ingest. A capture is one `PriPayload` JSON object per
+// line, the body /ingest accepts unchanged. The file is memory-mapped and every upload
+// is a QBuffer over its slice of the mapping, so frames go out without being copied into
+// a QByteArray. Frames are paced to a target rate with up to `maxInFlight` requests
+// outstanding, so the bridge parses one frame while the next is on the wire.
+class CaptureIngest : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Statistics
+    {
+        int frames = 0;
+        qint64 sent = 0;
+        qint64 acknowledged = 0;
+        qint64 failed = 0;
+        qint64 bytes = 0;
+        // Acknowledged frames per second over the last second.
+        double fps = 0.0;
+    };
+
+    CaptureIngest(EndpointPool* network, const QUrl& endpoint, QObject* parent = nullptr);
+    ~CaptureIngest() override;
+
+    // Maps `path` and indexes its frames; fails on unreadable, unmappable or empty files.
+    bool open(const QString& path, QString* error);
+    int frameCount() const { return frames_.size(); }
+    // Frames per second; 0 sends as fast as the in-flight window allows.
+    void setRate(double fps) { rate_fps_ = qMax(0.0, fps); }
+    void setMaxInFlight(int count);
+    void setLoop(bool loop) { loop_ = loop; }
+
+    bool isRunning() const { return running_; }
+    void start();
+    void stop();
+    Statistics statistics() const { return stats_; }
+
+signals:
+    // Throttled to a few updates per second.
+    void statisticsChanged(const CaptureIngest::Statistics& statistics);
+    // All frames acknowledged (never, while looping) or stop() called.
+    void finished();
+
+private:
+    struct Frame
+    {
+        qint64 offset;
+        qint64 size;
+    };
+
+    void pump();
+    void send(int index);
+    void onReplyFinished(QNetworkReply* reply);
+    void updateRate();
+    void finish();
+
+    EndpointPool* network_;
+    QUrl endpoint_;
+    QFile file_;
+    const uchar* map_ = nullptr;
+    QVector<Frame> frames_;
+    QVector<QNetworkReply*> replies_;
+    QTimer pace_timer_;
+    QTimer report_timer_;
+    QElapsedTimer clock_;
+    double rate_fps_ = 10.0;
+    int max_in_flight_ = 4;
+    bool loop_ = false;
+    bool running_ = false;
+    // Frames submitted since start(); the next frame is next_ % frames_.size().
+    qint64 next_ = 0;
+    qint64 window_acknowledged_ = 0;
+    qint64 window_start_ms_ = 0;
+    Statistics stats_;
+};
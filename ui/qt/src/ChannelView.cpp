@@ -0,0 +1,55 @@
+#include "ChannelView.h"
+
+#include "StatusGraph.h"
+#include "WaterfallView.h"
+#include <QLabel>
+#include <QVBoxLayout>
+
+#ifdef GMTI_HAVE_OPENGL
+#include "GlStatusGraph.h"
+#endif
+
+ChannelView::ChannelView(const QString& title, bool useGpu, QWidget* parent)
+    : QWidget(parent)
+{
+    auto* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(10);
+
+    if (!title.isEmpty()) {
+        title_ = new QLabel(title, this);
+        title_->setStyleSheet("color: #dddddd; font-weight: bold;");
+        layout->addWidget(title_);
+    }
+
+#ifdef GMTI_HAVE_OPENGL
+    if (useGpu) {
+        auto* glGraph = new GlStatusGraph(this);
+        graph_ = glGraph;
+    }
+#else
+    Q_UNUSED(useGpu);
+#endif
+    if (!graph_) {
+        graph_ = new StatusGraph(this);
+    }
+    graph_->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    layout->addWidget(graph_, 1);
+
+    waterfall_ = new WaterfallView(512, this);
+    waterfall_->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    layout->addWidget(waterfall_, 1);
+}
+
+void ChannelView::updateData(const FrameSnapshot& frame)
+{
+#ifdef GMTI_HAVE_OPENGL
+    if (auto* glGraph = qobject_cast<GlStatusGraph*>(graph_)) {
+        glGraph->updateData(frame);
+    } else
+#endif
+    {
+        static_cast<StatusGraph*>(graph_)->updateData(frame);
+    }
+    waterfall_->updateData(frame);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "FrameSnapshot.h"
+
+#include <QWidget>
+
+class QLabel;
+class WaterfallView;
+
+// Per-endpoint pair of profile graph and waterfall, optionally captioned with the
+// channel name when several engines are shown side by side.
+class ChannelView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    // `useGpu` picks GlStatusGraph when the build has OpenGL support.
+    ChannelView(const QString& title, bool useGpu, QWidget* parent = nullptr);
+
+public slots:
+    void updateData(const FrameSnapshot& frame);
+
+private:
+    QLabel* title_ = nullptr;
+    QWidget* graph_ = nullptr;
+    WaterfallView* waterfall_ = nullptr;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "DataProvider.h"
+
+#include <QString>
+#include <QUrl>
+#include <QVector>
+
+// Command-line switches for gmti_visualizer, parsed once in main().
+struct ClientOptions
+{
+    enum class Renderer
+    {
+        Auto,
+        Gpu,
+        Software
+    };
+
+    // One bridge the client fans frames in from; each gets its own channel view.
+    struct Endpoint
+    {
+        QString name;
+        QUrl url;
+    };
+
+    // Empty until parsed; main() falls back to the local bridge on port 9000.
+    QVector<Endpoint> endpoints;
+    bool streaming = true;
+    // HTTP/2 with prior knowledge instead of HTTP/1.1 keep-alive.
+    bool http2 = false;
+    DataProvider::WireFormat wire_format = DataProvider::WireFormat::Json;
+    Renderer renderer = Renderer::Auto;
+    bool show_diagnostics = false;
+    // Chart of the first bridge's GET /metrics pipeline timings.
+    bool show_engine_metrics = false;
+    // Written with the pipeline latency histograms when the client exits.
+    QString diagnostics_json;
+    // Raw replies from the first endpoint are appended here while connected.
+    QString record_path;
+    // When set, frames come from this recording instead of the bridge.
+    QString replay_path;
+    // Multiplier on the recorded timing; 0 replays as fast as decoding allows.
+    double replay_speed = 1.0;
+    bool replay_loop = false;
+    // Memory the detection history may hold before its oldest chunks are dropped.
+    int detection_memory_mb = 128;
+    // FramePool slots per decoder; frames beyond them fall back to fresh allocations.
+    int frame_buffers = 8;
+    // Offscreen platform: the window is rendered but never shown.
+    bool headless = false;
+    // Soak run length; 0 runs until closed. A soak over a replay loops the recording.
+    double soak_minutes = 0.0;
+    // Frame rate the soak must sustain; also fixes the poll interval when polling.
+    double soak_fps = 0.0;
+    // JSON soak report, written when the run ends.
+    QString soak_report;
+};
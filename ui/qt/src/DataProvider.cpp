@@ -1,65 +1,465 @@
 #include "DataProvider.h"
 
-#include <QCoreApplication>
-#include <QDir>
-#include <QJsonArray>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QNetworkAccessManager>
+#include "Diagnostics.h"
+#include "EndpointPool.h"
+#include "FrameDecoder.h"
+#include "FrameFormat.h"
+#include "FrameRecording.h"
+
+#include <QElapsedTimer>
 #include <QNetworkReply>
 #include <QNetworkRequest>
+#include <QPointer>
+#include <QSharedPointer>
 #include <QTimer>
 #include <QUrl>
+#include <QUrlQuery>
+
+#include <atomic>
+#include <utility>
+
+namespace
+{
+constexpr int kStreamRetryMs = 2000;
+constexpr int kDefaultMinPollMs = 100;
+constexpr int kDefaultMaxPollMs = 5000;
+// Flat-out replay keeps at most this many records queued on the decoder thread, posting
+// them in batches so the GUI event loop still gets to paint between batches.
+constexpr int kReplayMaxQueued = 16;
+constexpr int kReplayBatch = 4;
+
+bool isBinaryReply(const QNetworkReply* reply)
+{
+    return reply->header(QNetworkRequest::ContentTypeHeader).toString().startsWith(
+        QLatin1String(FrameFormat::kContentType));
+}
+} // namespace
 
 struct DataProvider::Impl
 {
     QTimer timer;
-    QNetworkAccessManager manager;
+    QTimer stream_retry;
+    QUrl base_url;
+    // Shared with every other channel, see EndpointPool.
+    EndpointPool* network = nullptr;
+    QPointer<QNetworkReply> stream;
+    QPointer<QNetworkReply> poll_reply;
+    QElapsedTimer poll_clock;
+    // Diagnostics::nowUs() stamps for the poll in flight.
+    qint64 poll_sent_us = 0;
+    qint64 poll_first_byte_us = 0;
+    int min_poll_ms = kDefaultMinPollMs;
+    int max_poll_ms = kDefaultMaxPollMs;
+    Statistics stats;
+    // Run and sequence of the newest frame handed to the widgets; sent back so the bridge
+    // can answer 304 or a delta instead of the whole model.
+    quint64 last_run_id = 0;
+    quint64 last_sequence = 0;
+    bool stream_binary = false;
+    bool streaming_enabled = false;
+    Transport transport = Transport::Polling;
+    WireFormat wire_format = WireFormat::Json;
+    // JSON parsing and record conversion run on a pooled thread so large frames never
+    // stall painting.
+    QPointer<FrameDecoder> decoder;
+
+    FrameRecording::Writer recorder;
+    // Shared with the queued decode calls so the mapping outlives any record still in flight.
+    QSharedPointer<FrameRecording::Reader> replay;
+    FrameRecording::Record replay_next;
+    bool replay_has_next = false;
+    bool replay_loop = false;
+    double replay_speed = 1.0;
+    QTimer replay_timer;
+    QElapsedTimer replay_clock;
+    // Outlives the provider with the queued decode calls that decrement it.
+    QSharedPointer<std::atomic<int>> replay_queued = QSharedPointer<std::atomic<int>>::create(0);
+
+    QUrl endpoint(const QString& path) const
+    {
+        QUrl url = base_url;
+        QString prefix = url.path();
+        if (prefix.endsWith(QLatin1Char('/'))) {
+            prefix.chop(1);
+        }
+        url.setPath(prefix + path);
+        return url;
+    }
+
+    QByteArray acceptHeader(const char* json_type) const
+    {
+        return wire_format == WireFormat::Binary ? QByteArray(FrameFormat::kContentType)
+                                                 : QByteArray(json_type);
+    }
+
+    template <typename Fn>
+    void post(Fn&& fn)
+    {
+        if (decoder) {
+            QMetaObject::invokeMethod(decoder.data(), std::forward<Fn>(fn), Qt::QueuedConnection);
+        }
+    }
 };
 
-DataProvider::DataProvider(QObject* parent)
+DataProvider::DataProvider(EndpointPool* pool, const QUrl& baseUrl, QObject* parent)
     : QObject(parent)
-    , d(new Impl{QTimer(parent), QNetworkAccessManager(parent)})
+    , d(new Impl)
 {
+    qRegisterMetaType<FrameSnapshot>();
+    d->base_url = baseUrl;
+    d->network = pool;
+    d->decoder = pool->createDecoder();
+    connect(d->decoder, &FrameDecoder::frameDecoded, this, [this](const FrameSnapshot& decoded) {
+        FrameSnapshot frame = decoded;
+        frame.dispatched_us = Diagnostics::nowUs();
+        auto& diagnostics = Diagnostics::instance();
+        diagnostics.record(Diagnostics::Stage::Dispatch, frame.dispatched_us - frame.decoded_us);
+        diagnostics.addFrame();
+        ++d->stats.frames;
+        d->last_run_id = frame.run_id;
+        d->last_sequence = frame.sequence;
+        emit dataReady(frame);
+        emit statisticsChanged();
+    });
+    connect(d->decoder, &FrameDecoder::framesDropped, this, [this](quint64 count) {
+        d->stats.dropped += count;
+        Diagnostics::instance().addDroppedFrames(count);
+        emit statisticsChanged();
+    });
+    connect(d->decoder, &FrameDecoder::streamCorrupted, this, [this]() {
+        if (d->stream) {
+            d->stream->abort();
+        }
+    });
+    connect(d->decoder, &FrameDecoder::resyncRequired, this, [this]() {
+        // Otherwise every later poll names the same frame and keeps getting the same delta
+        // (or a 304 for the old frame) until the bridge happens to publish again. A full
+        // model that fails to decode waits for the next tick rather than retrying at once.
+        if (d->last_sequence != 0) {
+            d->last_sequence = 0;
+            refresh();
+        }
+    });
+
+    d->stream_retry.setSingleShot(true);
+    d->stream_retry.setInterval(kStreamRetryMs);
     connect(&d->timer, &QTimer::timeout, this, &DataProvider::refresh);
+    connect(&d->stream_retry, &QTimer::timeout, this, &DataProvider::openStream);
+    d->replay_timer.setSingleShot(true);
+    connect(&d->replay_timer, &QTimer::timeout, this, &DataProvider::replayTick);
 }
 
 DataProvider::~DataProvider()
 {
+    if (d->stream) {
+        d->stream->disconnect(this);
+        d->stream->abort();
+    }
+    // Queued decode calls run first; the decoder is freed on its own thread afterwards.
+    if (d->decoder) {
+        d->decoder->deleteLater();
+    }
     delete d;
 }
 
 void DataProvider::start(int interval_ms)
 {
-    d->timer.setInterval(interval_ms);
+    d->stats.poll_interval_ms = qBound(d->min_poll_ms, interval_ms, d->max_poll_ms);
+    d->timer.setInterval(d->stats.poll_interval_ms);
     refresh();
     d->timer.start();
+    if (d->streaming_enabled) {
+        openStream();
+    }
+}
+
+void DataProvider::setPollIntervalBounds(int min_ms, int max_ms)
+{
+    d->min_poll_ms = qMax(1, min_ms);
+    d->max_poll_ms = qMax(d->min_poll_ms, max_ms);
+}
+
+void DataProvider::setStreamingEnabled(bool enabled)
+{
+    d->streaming_enabled = enabled;
+    if (!enabled) {
+        d->stream_retry.stop();
+        if (d->stream) {
+            d->stream->abort();
+        }
+    }
+}
+
+void DataProvider::setWireFormat(WireFormat format)
+{
+    d->wire_format = format;
+}
+
+bool DataProvider::setRecordingPath(const QString& path, QString* error)
+{
+    if (path.isEmpty()) {
+        d->recorder.close();
+        return true;
+    }
+    QString reason;
+    if (!d->recorder.open(path, &reason)) {
+        if (error) {
+            *error = reason;
+        }
+        return false;
+    }
+    return true;
+}
+
+bool DataProvider::startReplay(const QString& path, double speed, bool loop, QString* error)
+{
+    auto reader = QSharedPointer<FrameRecording::Reader>::create();
+    QString reason;
+    if (!reader->open(path, &reason) || reader->recordCount() == 0) {
+        if (error) {
+            *error = reason.isEmpty() ? tr("recording is empty") : reason;
+        }
+        return false;
+    }
+
+    // Detach from the bridge entirely; nothing below may flip the transport back.
+    d->timer.stop();
+    setStreamingEnabled(false);
+    if (d->poll_reply) {
+        d->poll_reply->abort();
+    }
+    setTransport(Transport::Replay);
+
+    d->replay = reader;
+    d->replay_speed = qMax(0.0, speed);
+    d->replay_loop = loop;
+    d->replay_has_next = d->replay->next(&d->replay_next);
+    d->post([decoder = d->decoder]() { decoder->reset(); });
+    d->replay_clock.start();
+    d->replay_timer.start(0);
+    return true;
+}
+
+QUrl DataProvider::baseUrl() const
+{
+    return d->base_url;
+}
+
+DataProvider::Transport DataProvider::transport() const
+{
+    return d->transport;
+}
+
+DataProvider::Statistics DataProvider::statistics() const
+{
+    return d->stats;
 }
 
 void DataProvider::refresh()
 {
-    QNetworkRequest request(QUrl("http://127.0.0.1:9000/payload"));
-    auto* reply = d->manager.get(request);
+    // While the push stream is live every frame already arrives through it.
+    if (d->transport != Transport::Polling) {
+        return;
+    }
+
+    // Never stack requests on a busy bridge: replies would pile up and arrive out of order.
+    if (d->poll_reply) {
+        ++d->stats.coalesced;
+        emit statisticsChanged();
+        return;
+    }
+
+    QUrl url = d->endpoint(QStringLiteral("/payload"));
+    // A hung reply would otherwise block every later tick through the in-flight check.
+    QNetworkRequest request = d->network->request(url, 2 * d->max_poll_ms);
+    if (d->last_sequence != 0) {
+        // Frames are named `<run_id>-<sequence>` so a restarted bridge never mistakes the
+        // previous run's frame for one of its own; bridges without run ids take the bare
+        // sequence.
+        QByteArray tag = QByteArray::number(d->last_sequence);
+        if (d->last_run_id != 0) {
+            tag.prepend(QByteArray::number(d->last_run_id) + '-');
+        }
+        // Binary frames have no delta encoding, so they only use the ETag for 304s.
+        if (d->wire_format == WireFormat::Json) {
+            QUrlQuery query;
+            query.addQueryItem(QStringLiteral("since"), QString::fromLatin1(tag));
+            url.setQuery(query);
+        }
+        request.setRawHeader("If-None-Match", '"' + tag + '"');
+    }
+    request.setUrl(url);
+    request.setRawHeader("Accept", d->acceptHeader("application/json"));
+    auto* reply = d->network->get(request);
+    d->poll_reply = reply;
+    d->poll_clock.start();
+    d->poll_sent_us = Diagnostics::nowUs();
+    d->poll_first_byte_us = 0;
+    connect(reply, &QNetworkReply::metaDataChanged, this, [this]() {
+        if (d->poll_first_byte_us == 0) {
+            d->poll_first_byte_us = Diagnostics::nowUs();
+            Diagnostics::instance().record(Diagnostics::Stage::FirstByte, d->poll_first_byte_us - d->poll_sent_us);
+        }
+    });
     connect(reply, &QNetworkReply::finished, this, [this, reply]() {
         reply->deleteLater();
-        if (reply->error() != QNetworkReply::NoError) {
+        d->poll_reply = nullptr;
+        const qint64 received_us = Diagnostics::nowUs();
+        const bool failed = reply->error() != QNetworkReply::NoError;
+        adaptPollInterval(d->poll_clock.elapsed(), failed);
+        const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (failed || status == 304) {
             return;
         }
+        auto& diagnostics = Diagnostics::instance();
+        diagnostics.record(Diagnostics::Stage::Transfer,
+                           received_us - (d->poll_first_byte_us != 0 ? d->poll_first_byte_us : d->poll_sent_us));
+        const QByteArray body = reply->readAll();
+        diagnostics.addBytes(body.size());
+        d->recorder.append(body, isBinaryReply(reply) ? FrameRecording::BinaryPayload : 0u, received_us);
+        d->post([decoder = d->decoder, body, binary = isBinaryReply(reply), origin = d->poll_sent_us, received_us]() {
+            decoder->decodePayload(body, binary, origin, received_us);
+        });
+    });
+}
 
-        const auto doc = QJsonDocument::fromJson(reply->readAll());
-        if (!doc.isObject()) {
+void DataProvider::openStream()
+{
+    if (!d->streaming_enabled || d->stream) {
+        return;
+    }
+
+    // No transfer timeout: the bridge may go quiet between runs without the stream failing.
+    QNetworkRequest request = d->network->request(d->endpoint(QStringLiteral("/stream")), 0);
+    request.setRawHeader("Accept", d->acceptHeader("application/x-ndjson"));
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+    d->post([decoder = d->decoder]() { decoder->resetStream(); });
+    d->recorder.append(QByteArray(), FrameRecording::StreamReset, Diagnostics::nowUs());
+    d->stream = d->network->get(request);
+    connect(d->stream, &QNetworkReply::readyRead, this, &DataProvider::onStreamData);
+    connect(d->stream, &QNetworkReply::finished, this, &DataProvider::onStreamFinished);
+}
+
+void DataProvider::onStreamData()
+{
+    if (!d->stream) {
+        return;
+    }
+    if (d->transport != Transport::Streaming) {
+        // An older bridge answers /stream with 404; stay on polling and let finished() retry.
+        if (d->stream->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200) {
+            d->stream->readAll();
             return;
         }
+        d->stream_binary = isBinaryReply(d->stream);
+        setTransport(Transport::Streaming);
+    }
 
-        const auto obj = doc.object();
-        const auto powerArray = obj.value("power_profile").toArray();
-        QVector<double> profile;
-        profile.reserve(powerArray.size());
-        for (const auto& value : powerArray) {
-            profile.append(value.toDouble());
+    // Only the raw bytes cross threads; framing and decoding happen on the decoder thread.
+    const QByteArray chunk = d->stream->readAll();
+    const qint64 received_us = Diagnostics::nowUs();
+    Diagnostics::instance().addBytes(chunk.size());
+    d->recorder.append(chunk,
+                       FrameRecording::StreamChunk | (d->stream_binary ? FrameRecording::BinaryPayload : 0u),
+                       received_us);
+    d->post([decoder = d->decoder, chunk, binary = d->stream_binary, received_us]() {
+        decoder->appendStreamData(chunk, binary, received_us);
+    });
+}
+
+void DataProvider::onStreamFinished()
+{
+    if (d->stream) {
+        d->stream->deleteLater();
+        d->stream = nullptr;
+    }
+
+    if (d->transport == Transport::Replay) {
+        return;
+    }
+
+    // Fall back to polling until the bridge accepts a new stream.
+    setTransport(Transport::Polling);
+    if (d->streaming_enabled) {
+        d->stream_retry.start();
+    }
+}
+
+void DataProvider::adaptPollInterval(qint64 latency_ms, bool failed)
+{
+    int interval = d->stats.poll_interval_ms;
+    if (failed || latency_ms * 2 > interval) {
+        // Back off quickly while the bridge is slow or down...
+        interval = qMin(d->max_poll_ms, interval * 2);
+    } else if (latency_ms * 4 < interval) {
+        // ...and tighten gradually once it answers well within the tick.
+        interval = qMax(d->min_poll_ms, interval * 3 / 4);
+    }
+    if (interval != d->stats.poll_interval_ms) {
+        d->stats.poll_interval_ms = interval;
+        d->timer.setInterval(interval);
+        emit statisticsChanged();
+    }
+}
+
+void DataProvider::setTransport(Transport transport)
+{
+    if (d->transport == transport) {
+        return;
+    }
+    d->transport = transport;
+    emit transportChanged(transport);
+}
+
+void DataProvider::replayTick()
+{
+    const bool flatOut = d->replay_speed <= 0.0;
+    int batch = 0;
+    while (d->replay_has_next) {
+        if (flatOut) {
+            // Let the decoder catch up rather than queueing the whole file on its thread.
+            if (d->replay_queued->load(std::memory_order_relaxed) >= kReplayMaxQueued) {
+                d->replay_timer.start(1);
+                return;
+            }
+        } else {
+            const qint64 due_us = static_cast<qint64>(d->replay_next.arrival_us / d->replay_speed);
+            const qint64 elapsed_us = d->replay_clock.nsecsElapsed() / 1000;
+            if (due_us > elapsed_us) {
+                d->replay_timer.start(static_cast<int>((due_us - elapsed_us + 999) / 1000));
+                return;
+            }
         }
 
-        const int detections = obj.value("detection_count").toInt(0);
-        emit dataReady(profile, detections);
-    });
+        const FrameRecording::Record& record = d->replay_next;
+        const qint64 now_us = Diagnostics::nowUs();
+        Diagnostics::instance().addBytes(record.payload.size());
+        d->replay_queued->fetch_add(1, std::memory_order_relaxed);
+        d->post([decoder = d->decoder, source = d->replay, payload = record.payload, flags = record.flags,
+                 queued = d->replay_queued, now_us]() {
+            const bool binary = (flags & FrameRecording::BinaryPayload) != 0;
+            if (flags & FrameRecording::StreamReset) {
+                decoder->resetStream();
+            } else if (flags & FrameRecording::StreamChunk) {
+                decoder->appendStreamData(payload, binary, now_us);
+            } else {
+                decoder->decodePayload(payload, binary, now_us, now_us);
+            }
+            queued->fetch_sub(1, std::memory_order_relaxed);
+        });
+
+        d->replay_has_next = d->replay->next(&d->replay_next);
+        if (!d->replay_has_next && d->replay_loop) {
+            // Sequences start over with the file, so the decoder must forget the last frame.
+            d->replay->rewind();
+            d->replay_has_next = d->replay->next(&d->replay_next);
+            d->post([decoder = d->decoder]() { decoder->reset(); });
+            d->replay_clock.restart();
+        }
+        if (flatOut && ++batch >= kReplayBatch) {
+            d->replay_timer.start(0);
+            return;
+        }
+    }
+    emit replayFinished();
 }
@@ -1,24 +1,80 @@
 #pragma once
 
+#include "FrameSnapshot.h"
+
 #include <QObject>
-#include <QVector>
+#include <QUrl>
+
+class EndpointPool;
 
+// One bridge endpoint (channel): polls or streams its frames, decodes them on a pooled
+// decoder thread, and emits them in sequence order.
 class DataProvider : public QObject
 {
     Q_OBJECT
 
 public:
-    explicit DataProvider(QObject* parent = nullptr);
+    enum class Transport
+    {
+        Polling,
+        Streaming,
+        // Frames come from a FrameRecording file instead of the bridge.
+        Replay
+    };
+    Q_ENUM(Transport)
+
+    enum class WireFormat
+    {
+        Json,
+        Binary
+    };
+    Q_ENUM(WireFormat)
+
+    struct Statistics
+    {
+        quint64 frames = 0;
+        // Frames the bridge published that never reached the widgets (gaps or stale replies).
+        quint64 dropped = 0;
+        // Poll ticks skipped because the previous /payload reply was still outstanding.
+        quint64 coalesced = 0;
+        int poll_interval_ms = 0;
+    };
+
+    // `baseUrl` is the bridge root, e.g. http://127.0.0.1:9000; `pool` must outlive start().
+    DataProvider(EndpointPool* pool, const QUrl& baseUrl, QObject* parent = nullptr);
     ~DataProvider();
+    QUrl baseUrl() const;
     void start(int interval_ms = 1000);
+    // Bounds for the adaptive poll interval; start() begins at its argument and the
+    // interval then backs off while replies are slow and tightens while they are fast.
+    void setPollIntervalBounds(int min_ms, int max_ms);
+    void setStreamingEnabled(bool enabled);
+    void setWireFormat(WireFormat format);
+    // Appends every raw /payload body and /stream chunk to `path` (FrameRecording layout).
+    bool setRecordingPath(const QString& path, QString* error = nullptr);
+    // Replaces the bridge with a recording. `speed` scales the recorded timing (2.0 is twice
+    // as fast); 0 feeds frames as fast as the decoder drains them.
+    bool startReplay(const QString& path, double speed, bool loop, QString* error = nullptr);
+    Transport transport() const;
+    Statistics statistics() const;
 
 signals:
-    void dataReady(const QVector<double>& profile, int detectionCount);
+    void dataReady(const FrameSnapshot& frame);
+    void transportChanged(DataProvider::Transport transport);
+    void statisticsChanged();
+    void replayFinished();
 
 private slots:
     void refresh();
+    void openStream();
 
 private:
-    class Impl;
+    void onStreamData();
+    void onStreamFinished();
+    void adaptPollInterval(qint64 latency_ms, bool failed);
+    void setTransport(Transport transport);
+    void replayTick();
+
+    struct Impl;
     Impl* d;
 };
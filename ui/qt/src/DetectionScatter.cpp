@@ -0,0 +1,283 @@
+#include "DetectionScatter.h"
+
+#include "DetectionStore.h"
+#include "RenderScheduler.h"
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QToolTip>
+#include <QWheelEvent>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// SNR bands (dB) coloured from the waterfall palette, weakest first.
+constexpr float kSnrBands[] = {10.0f, 15.0f, 20.0f};
+const QColor kBandColours[] = {QColor(0, 90, 200), QColor(0, 190, 255), QColor(255, 220, 0),
+                               QColor(255, 255, 255)};
+constexpr float kVolumeRadiusM = 10000.0f;
+constexpr float kRingSpacingM = 2500.0f;
+constexpr float kMinExtentM = 100.0f;
+constexpr float kMaxExtentM = 2.0f * DetectionStore::kGridExtentM;
+constexpr qreal kPickRadiusPx = 6.0;
+constexpr int kDragThresholdPx = 4;
+
+int snrBand(float snr)
+{
+    int band = 0;
+    for (float limit : kSnrBands) {
+        if (snr < limit) {
+            break;
+        }
+        ++band;
+    }
+    return band;
+}
+} // namespace
+
+DetectionScatter::DetectionScatter(const DetectionStore* store, QWidget* parent)
+    : QWidget(parent)
+    , store_(store)
+{
+    setMinimumSize(200, 200);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setMouseTracking(true);
+    connect(store_, &DetectionStore::rowsAppended, this, &DetectionScatter::scheduleUpdate);
+    connect(store_, &DetectionStore::rowsEvicted, this, &DetectionScatter::onRowsEvicted);
+    connect(store_, &DetectionStore::cleared, this, &DetectionScatter::onRowsEvicted);
+}
+
+void DetectionScatter::setExtent(float metres)
+{
+    extent_m_ = std::clamp(metres, kMinExtentM, kMaxExtentM);
+    update();
+}
+
+void DetectionScatter::setFilter(double windowSeconds, float minSnr, int channel)
+{
+    window_s_ = qMax(0.0, windowSeconds);
+    min_snr_ = minSnr;
+    channel_ = channel;
+    update();
+}
+
+DetectionStore::Filter DetectionScatter::currentFilter() const
+{
+    DetectionStore::Filter filter = store_->windowFilter(window_s_);
+    filter.min_snr = min_snr_;
+    filter.channel = channel_;
+    return filter;
+}
+
+void DetectionScatter::scheduleUpdate()
+{
+    RenderScheduler::instance().requestUpdate(this);
+}
+
+void DetectionScatter::onRowsEvicted()
+{
+    selected_.erase(std::remove_if(selected_.begin(), selected_.end(),
+                                   [this](qint64 id) { return store_->rowOf(id) < 0; }),
+                    selected_.end());
+    if (store_->rowOf(hovered_id_) < 0) {
+        hovered_id_ = -1;
+    }
+    scheduleUpdate();
+}
+
+qreal DetectionScatter::pixelsPerMetre() const
+{
+    return (qMin(width(), height()) / 2.0 - 4.0) / extent_m_;
+}
+
+QPointF DetectionScatter::toScreen(float east, float north) const
+{
+    const QPointF centre = QRectF(rect()).center();
+    const qreal scale = pixelsPerMetre();
+    return QPointF(centre.x() + (east - view_centre_m_.x()) * scale,
+                   centre.y() - (north - view_centre_m_.y()) * scale);
+}
+
+QPointF DetectionScatter::toMetres(const QPointF& screen) const
+{
+    const QPointF centre = QRectF(rect()).center();
+    const qreal scale = pixelsPerMetre();
+    return QPointF(view_centre_m_.x() + (screen.x() - centre.x()) / scale,
+                   view_centre_m_.y() - (screen.y() - centre.y()) / scale);
+}
+
+QRectF DetectionScatter::visibleMetres() const
+{
+    return QRectF(toMetres(QPointF(0, 0)), toMetres(QPointF(width(), height()))).normalized();
+}
+
+void DetectionScatter::paintEvent(QPaintEvent*)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(22, 22, 22));
+
+    const QPointF origin = toScreen(0.0f, 0.0f);
+    const qreal scale = pixelsPerMetre();
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QColor(60, 60, 60));
+    for (float r = kRingSpacingM; r <= kVolumeRadiusM; r += kRingSpacingM) {
+        painter.drawEllipse(origin, r * scale, r * scale);
+    }
+    const qreal axis = kVolumeRadiusM * scale;
+    painter.drawLine(QPointF(origin.x() - axis, origin.y()), QPointF(origin.x() + axis, origin.y()));
+    painter.drawLine(QPointF(origin.x(), origin.y() - axis), QPointF(origin.x(), origin.y() + axis));
+    painter.setRenderHint(QPainter::Antialiasing, false);
+
+    if (store_->size() == 0) {
+        painter.setPen(Qt::gray);
+        painter.drawText(rect(), Qt::AlignCenter, tr("No detections"));
+        return;
+    }
+
+    // Only chunks and grid cells overlapping the viewport and the filter are visited;
+    // points are bucketed by SNR band so each band costs a single draw call.
+    for (auto& band : points_) {
+        band.clear();
+    }
+    int visible = 0;
+    store_->forEachIn(
+        visibleMetres(),
+        [&](int row) {
+            points_[snrBand(store_->snr(row))].append(toScreen(store_->east(row), store_->north(row)));
+            ++visible;
+        },
+        currentFilter());
+    for (int band = 0; band < 4; ++band) {
+        if (points_[band].isEmpty()) {
+            continue;
+        }
+        painter.setPen(QPen(kBandColours[band], 2.0));
+        painter.drawPoints(points_[band].constData(), points_[band].size());
+    }
+
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QPen(QColor(255, 80, 80), 1.5));
+    painter.setBrush(Qt::NoBrush);
+    for (qint64 id : selected_) {
+        const int row = store_->rowOf(id);
+        painter.drawEllipse(toScreen(store_->east(row), store_->north(row)), 4.0, 4.0);
+    }
+    if (const int row = store_->rowOf(hovered_id_); row >= 0) {
+        painter.setPen(QPen(Qt::white, 1.5));
+        painter.drawEllipse(toScreen(store_->east(row), store_->north(row)), 6.0, 6.0);
+    }
+    if (drag_ == Drag::Select) {
+        painter.setPen(QPen(QColor(0, 190, 255), 1.0, Qt::DashLine));
+        painter.drawRect(QRect(press_pos_, drag_pos_).normalized());
+    }
+
+    painter.setPen(Qt::gray);
+    painter.drawText(rect().adjusted(6, 4, -6, -4), Qt::AlignTop | Qt::AlignLeft,
+                     tr("%1 of %2 detections | %3 km")
+                         .arg(visible)
+                         .arg(store_->size())
+                         .arg(extent_m_ / 1000.0f, 0, 'f', 1));
+}
+
+void DetectionScatter::wheelEvent(QWheelEvent* event)
+{
+    // Zoom about the cursor: keep the point under it fixed on screen.
+    const QPointF cursor = event->position();
+    const QPointF anchor = toMetres(cursor);
+    const qreal steps = event->angleDelta().y() / 120.0;
+    setExtent(static_cast<float>(extent_m_ * std::pow(0.8, steps)));
+    view_centre_m_ += anchor - toMetres(cursor);
+    event->accept();
+}
+
+void DetectionScatter::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() != Qt::LeftButton) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+    press_pos_ = drag_pos_ = event->position().toPoint();
+    press_centre_m_ = view_centre_m_;
+    drag_ = event->modifiers() & Qt::ShiftModifier ? Drag::Select : Drag::Pan;
+}
+
+void DetectionScatter::mouseMoveEvent(QMouseEvent* event)
+{
+    const QPoint pos = event->position().toPoint();
+    if (drag_ == Drag::Pan) {
+        drag_pos_ = pos;
+        view_centre_m_ = press_centre_m_ - QPointF(pos.x() - press_pos_.x(), press_pos_.y() - pos.y()) /
+                                               pixelsPerMetre();
+        update();
+        return;
+    }
+    if (drag_ == Drag::Select) {
+        drag_pos_ = pos;
+        update();
+        return;
+    }
+
+    const int row = store_->nearest(toMetres(pos), static_cast<float>(kPickRadiusPx / pixelsPerMetre()),
+                                    currentFilter());
+    const qint64 id = row >= 0 ? store_->idAt(row) : -1;
+    if (id == hovered_id_) {
+        return;
+    }
+    hovered_id_ = id;
+    if (row >= 0) {
+        QString text = tr("Range %1 m\nBearing %2 deg\nDoppler %3 m/s\nSNR %4 dB")
+                           .arg(store_->range(row), 0, 'f', 1)
+                           .arg(store_->bearing(row), 0, 'f', 1)
+                           .arg(store_->doppler(row), 0, 'f', 2)
+                           .arg(store_->snr(row), 0, 'f', 1);
+        const int channel = store_->channel(row);
+        if (channel_names_.size() > 1 && channel < channel_names_.size()) {
+            text.prepend(tr("Channel %1\n").arg(channel_names_[channel]));
+        }
+        QToolTip::showText(event->globalPosition().toPoint(), text, this);
+    } else {
+        QToolTip::hideText();
+    }
+    update();
+}
+
+void DetectionScatter::mouseReleaseEvent(QMouseEvent* event)
+{
+    if (event->button() != Qt::LeftButton || drag_ == Drag::None) {
+        QWidget::mouseReleaseEvent(event);
+        return;
+    }
+    const Drag drag = drag_;
+    drag_ = Drag::None;
+    const QPoint pos = event->position().toPoint();
+    const bool moved = (pos - press_pos_).manhattanLength() > kDragThresholdPx;
+
+    if (drag == Drag::Select && moved) {
+        selectRows(store_->rowsIn(QRectF(toMetres(press_pos_), toMetres(pos)), currentFilter()));
+    } else if (!moved) {
+        const int row = store_->nearest(toMetres(pos), static_cast<float>(kPickRadiusPx / pixelsPerMetre()),
+                                        currentFilter());
+        selectRows(row >= 0 ? QVector<int>{row} : QVector<int>());
+    }
+    update();
+}
+
+void DetectionScatter::leaveEvent(QEvent* event)
+{
+    if (hovered_id_ >= 0) {
+        hovered_id_ = -1;
+        update();
+    }
+    QWidget::leaveEvent(event);
+}
+
+void DetectionScatter::selectRows(const QVector<int>& rows)
+{
+    selected_.clear();
+    selected_.reserve(rows.size());
+    for (int row : rows) {
+        selected_.append(store_->idAt(row));
+    }
+    emit detectionsSelected(rows);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "DetectionStore.h"
+
+#include <QPoint>
+#include <QPointF>
+#include <QRectF>
+#include <QStringList>
+#include <QVector>
+#include <QWidget>
+
+// Plan-view scatter of the stored detections (east/north metres). Wheel zooms about the
+// cursor, dragging pans, shift-drag box-selects and a click picks the nearest detection.
+// Painting and every mouse query go through the store's chunk and grid index, so the cost
+// follows what is on screen rather than the size of the history. An optional time window
+// (relative to each channel's newest detection), SNR threshold and channel limit what is
+// drawn and picked.
+class DetectionScatter : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit DetectionScatter(const DetectionStore* store, QWidget* parent = nullptr);
+
+    void setExtent(float metres);
+    // Named in the hover tooltip when there is more than one, indexed by store channel.
+    void setChannelNames(const QStringList& names) { channel_names_ = names; }
+    // Show only the last `windowSeconds` of detections (0: all) at or above `minSnr` dB,
+    // from `channel` alone or, with -1, from every channel.
+    void setFilter(double windowSeconds, float minSnr, int channel = -1);
+    // Selection is tracked by store row id so it survives eviction of older rows.
+    QVector<qint64> selection() const { return selected_; }
+
+signals:
+    // Rows (current store indices) picked or box-selected by the user.
+    void detectionsSelected(const QVector<int>& rows);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void leaveEvent(QEvent* event) override;
+
+private:
+    enum class Drag
+    {
+        None,
+        Pan,
+        Select
+    };
+
+    void scheduleUpdate();
+    void onRowsEvicted();
+    qreal pixelsPerMetre() const;
+    QPointF toScreen(float east, float north) const;
+    QPointF toMetres(const QPointF& screen) const;
+    QRectF visibleMetres() const;
+    void selectRows(const QVector<int>& rows);
+    DetectionStore::Filter currentFilter() const;
+
+    const DetectionStore* store_;
+    float extent_m_ = 10000.0f;
+    double window_s_ = 0.0;
+    float min_snr_ = -std::numeric_limits<float>::infinity();
+    int channel_ = -1;
+    QStringList channel_names_;
+    QPointF view_centre_m_;
+    QVector<QPointF> points_[4];
+    QVector<qint64> selected_;
+    qint64 hovered_id_ = -1;
+    Drag drag_ = Drag::None;
+    QPoint press_pos_;
+    QPoint drag_pos_;
+    QPointF press_centre_m_;
+};
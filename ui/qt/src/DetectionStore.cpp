@@ -0,0 +1,211 @@
+#include "DetectionStore.h"
+
+#include <QtMath>
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+// Never fewer than two chunks, so eviction always leaves the newest history behind.
+constexpr int kMinChunks = 2;
+} // namespace
+
+void DetectionStore::Chunk::reset()
+{
+    count = 0;
+    indexed = false;
+    time_ordered = true;
+    channels = 0;
+}
+
+void DetectionStore::Chunk::add(const FrameFormat::DetectionRecord& record, int channel)
+{
+    const float theta = qDegreesToRadians(record.bearing_deg);
+    const float x = record.range * std::sin(theta);
+    const float y = record.range * std::cos(theta);
+    const int offset = count++;
+    if (offset == 0) {
+        min_time = max_time = record.timestamp;
+        max_snr = record.snr;
+        min_east = max_east = x;
+        min_north = max_north = y;
+    } else {
+        time_ordered = time_ordered && record.timestamp >= timestamp[offset - 1];
+        min_time = std::min(min_time, record.timestamp);
+        max_time = std::max(max_time, record.timestamp);
+        max_snr = std::max(max_snr, record.snr);
+        min_east = std::min(min_east, x);
+        max_east = std::max(max_east, x);
+        min_north = std::min(min_north, y);
+        max_north = std::max(max_north, y);
+    }
+    timestamp[offset] = record.timestamp;
+    range[offset] = record.range;
+    doppler[offset] = record.doppler;
+    snr[offset] = record.snr;
+    bearing[offset] = record.bearing_deg;
+    elevation[offset] = record.elevation_deg;
+    east[offset] = x;
+    north[offset] = y;
+    this->channel[offset] = static_cast<quint8>(channel);
+    channels |= quint64(1) << channel;
+    cell_key[offset] = static_cast<quint16>(cellOf(y) * kGridCells + cellOf(x));
+}
+
+void DetectionStore::Chunk::buildIndex()
+{
+    // Stable, so rows stay ascending within each cell.
+    std::iota(by_cell.begin(), by_cell.begin() + count, quint16(0));
+    std::stable_sort(by_cell.begin(), by_cell.begin() + count,
+                     [this](quint16 a, quint16 b) { return cell_key[a] < cell_key[b]; });
+    std::sort(cell_key.begin(), cell_key.begin() + count);
+    indexed = true;
+}
+
+DetectionStore::DetectionStore(qint64 memoryBudgetBytes, QObject* parent)
+    : QObject(parent)
+    , max_chunks_(static_cast<int>(qMax<qint64>(kMinChunks, memoryBudgetBytes / qint64(sizeof(Chunk)))))
+{
+}
+
+DetectionStore::~DetectionStore() = default;
+
+qint64 DetectionStore::memoryUsed() const
+{
+    return static_cast<qint64>(chunks_.size() + (spare_ ? 1 : 0)) * qint64(sizeof(Chunk));
+}
+
+int DetectionStore::rowOf(qint64 id) const
+{
+    const qint64 row = id - first_id_;
+    return row >= 0 && row < size() ? static_cast<int>(row) : -1;
+}
+
+void DetectionStore::append(const QVector<FrameFormat::DetectionRecord>& records, int channel)
+{
+    if (records.isEmpty()) {
+        return;
+    }
+    channel = std::clamp(channel, 0, kMaxChannels - 1);
+    if (channel >= latest_by_channel_.size()) {
+        latest_by_channel_.resize(channel + 1, -std::numeric_limits<double>::infinity());
+    }
+    double& channelLatest = latest_by_channel_[channel];
+    // A frame larger than the whole store keeps only its newest rows.
+    const int count = qMin<int>(records.size(), capacity());
+    const auto* begin = records.constData() + (records.size() - count);
+
+    // Drop whole chunks up front so the rows appended below keep their indices.
+    auto chunksNeeded = [this, count]() {
+        const int tailFree = chunks_.empty() ? 0 : kChunkRows - chunks_.back()->count;
+        const int overflow = count - tailFree;
+        return static_cast<int>(chunks_.size()) + (overflow > 0 ? (overflow + kChunkRows - 1) / kChunkRows : 0);
+    };
+    int evicted = 0;
+    while (!chunks_.empty() && chunksNeeded() > max_chunks_) {
+        evicted += evictOldest();
+    }
+    if (evicted > 0) {
+        emit rowsEvicted(evicted);
+    }
+
+    const int first = size_;
+    for (int i = 0; i < count; ++i) {
+        if (chunks_.empty() || chunks_.back()->count == kChunkRows) {
+            if (!chunks_.empty()) {
+                chunks_.back()->buildIndex();
+            }
+            std::unique_ptr<Chunk> chunk = spare_ ? std::move(spare_) : std::make_unique<Chunk>();
+            chunk->reset();
+            chunks_.push_back(std::move(chunk));
+        }
+        chunks_.back()->add(begin[i], channel);
+        latest_timestamp_ = size_ == 0 && i == 0 ? begin[i].timestamp : std::max(latest_timestamp_, begin[i].timestamp);
+        channelLatest = std::max(channelLatest, begin[i].timestamp);
+    }
+    size_ += count;
+    emit rowsAppended(first, first + count - 1);
+}
+
+int DetectionStore::evictOldest()
+{
+    std::unique_ptr<Chunk> oldest = std::move(chunks_.front());
+    chunks_.pop_front();
+    const int rows = oldest->count;
+    size_ -= rows;
+    first_id_ += rows;
+    spare_ = std::move(oldest);
+    return rows;
+}
+
+void DetectionStore::clear()
+{
+    first_id_ += size_;
+    size_ = 0;
+    latest_timestamp_ = 0.0;
+    latest_by_channel_.clear();
+    if (!chunks_.empty()) {
+        spare_ = std::move(chunks_.back());
+    }
+    chunks_.clear();
+    emit cleared();
+}
+
+DetectionStore::Filter DetectionStore::windowFilter(double windowSeconds) const
+{
+    Filter filter;
+    if (windowSeconds > 0.0) {
+        filter.channel_from_time.reserve(latest_by_channel_.size());
+        for (double latest : latest_by_channel_) {
+            filter.channel_from_time.append(latest - windowSeconds);
+        }
+    }
+    return filter;
+}
+
+int DetectionStore::nearest(const QPointF& point_m, float radius_m, const Filter& filter) const
+{
+    int best = -1;
+    float bestDistance = radius_m * radius_m;
+    const QRectF area(point_m.x() - radius_m, point_m.y() - radius_m, 2 * radius_m, 2 * radius_m);
+    forEachIn(
+        area,
+        [&](int row) {
+            const float dx = east(row) - static_cast<float>(point_m.x());
+            const float dy = north(row) - static_cast<float>(point_m.y());
+            const float distance = dx * dx + dy * dy;
+            if (distance <= bestDistance) {
+                bestDistance = distance;
+                best = row;
+            }
+        },
+        filter);
+    return best;
+}
+
+QVector<int> DetectionStore::rowsIn(const QRectF& area_m, const Filter& filter) const
+{
+    QVector<int> rows;
+    forEachIn(area_m, [&rows](int row) { rows.append(row); }, filter);
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+QVector<int> DetectionStore::rowsMatching(const Filter& filter, int firstRow) const
+{
+    QVector<int> rows;
+    forEachMatching(filter, [&rows](int row) { rows.append(row); }, firstRow);
+    return rows;
+}
+
+int DetectionStore::cellOf(float metres)
+{
+    const int cell = static_cast<int>(std::floor((metres + kGridExtentM) / kCellSizeM));
+    return std::clamp(cell, 0, kGridCells - 1);
+}
+
+QRect DetectionStore::cellRange(const QRectF& area_m) const
+{
+    return QRect(QPoint(cellOf(area_m.left()), cellOf(area_m.top())),
+                 QPoint(cellOf(area_m.right()), cellOf(area_m.bottom())));
+}
@@ -0,0 +1,271 @@
+#pragma once
+
+#include "FrameFormat.h"
+
+#include <QObject>
+#include <QPointF>
+#include <QRect>
+#include <QRectF>
+#include <QVector>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <limits>
+#include <memory>
+
+// Query predicate for DetectionStore; the defaults accept every row. It lives outside the
+// class so its member initialisers are usable in the store's default arguments.
+struct DetectionFilter
+{
+    double from_time = -std::numeric_limits<double>::infinity();
+    double to_time = std::numeric_limits<double>::infinity();
+    float min_snr = -std::numeric_limits<float>::infinity();
+    // The only channel accepted, or -1 for all of them.
+    int channel = -1;
+    // Extra lower time bound per channel, indexed by channel; channels past its end only
+    // use from_time. Engines keep independent clocks, so a time window is set per channel
+    // (see DetectionStore::windowFilter).
+    QVector<double> channel_from_time;
+
+    double fromTime(int ch) const
+    {
+        return ch < channel_from_time.size() ? std::max(from_time, channel_from_time[ch]) : from_time;
+    }
+    // Lowest time bound over the accepted channels among the first `channels`, for
+    // skipping whole chunks and bounding searches.
+    double earliestFrom(int channels) const
+    {
+        if (channel >= 0) {
+            return fromTime(channel);
+        }
+        double earliest = channels > 0 ? std::numeric_limits<double>::infinity() : from_time;
+        for (int ch = 0; ch < channels; ++ch) {
+            earliest = std::min(earliest, fromTime(ch));
+        }
+        return earliest;
+    }
+    bool accepts(double timestamp, float snr, int ch) const
+    {
+        return (channel < 0 || ch == channel) && timestamp >= fromTime(ch) && timestamp <= to_time &&
+               snr >= min_snr;
+    }
+};
+
+// Append-only history of every detection received this session, held in fixed-size
+// columnar chunks. The chunk count is capped by a memory budget set once; when the
+// store is full the oldest chunk is dropped whole and recycled for the next append,
+// so hours of history cost no allocation after warm-up and never grow past the budget.
+//
+// Every chunk records the time span, SNR ceiling and plan-view bounds of its rows, so a
+// time-window, SNR-threshold or area query skips the chunks it cannot match. Inside a
+// chunk, rows are bucketed by a uniform grid over the surveillance volume (east/north
+// metres). Picking, box selection and draw-time culling therefore touch only the chunks
+// and cells they overlap.
+//
+// Each row also records the channel (bridge endpoint) it came from. Channels keep their
+// own newest timestamp, since engines' clocks are independent.
+class DetectionStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    // The grid spans slightly more than the ±10 km volume; anything further out is kept
+    // in the border cells, so queries stay exact and only get slower out there.
+    static constexpr float kGridExtentM = 12000.0f;
+    static constexpr int kGridCells = 96;
+    static constexpr float kCellSizeM = 2.0f * kGridExtentM / kGridCells;
+    // Rows per chunk; a power of two so a row splits into chunk and offset by shifting.
+    static constexpr int kChunkShift = 13;
+    static constexpr int kChunkRows = 1 << kChunkShift;
+    static constexpr qint64 kDefaultMemoryBudget = qint64(128) << 20;
+    // Channels are stored in a byte and tracked per chunk in a 64-bit mask.
+    static constexpr int kMaxChannels = 64;
+
+    using Filter = DetectionFilter;
+
+    explicit DetectionStore(qint64 memoryBudgetBytes = kDefaultMemoryBudget, QObject* parent = nullptr);
+    ~DetectionStore() override;
+
+    // `channel` is clamped to [0, kMaxChannels).
+    void append(const QVector<FrameFormat::DetectionRecord>& records, int channel = 0);
+    void clear();
+
+    int size() const { return size_; }
+    int capacity() const { return max_chunks_ * kChunkRows; }
+    // Bytes held by chunks, including the recycled spare, and the most they may take.
+    qint64 memoryUsed() const;
+    qint64 memoryBudget() const { return qint64(max_chunks_) * qint64(sizeof(Chunk)); }
+
+    // Row ids stay valid across evictions, unlike row indices which shift down.
+    qint64 idAt(int row) const { return first_id_ + row; }
+    // Current row of `id`, or -1 once it has been evicted.
+    int rowOf(qint64 id) const;
+
+    double timestamp(int row) const { return chunkOf(row).timestamp[row & kOffsetMask]; }
+    float range(int row) const { return chunkOf(row).range[row & kOffsetMask]; }
+    float doppler(int row) const { return chunkOf(row).doppler[row & kOffsetMask]; }
+    float snr(int row) const { return chunkOf(row).snr[row & kOffsetMask]; }
+    float bearing(int row) const { return chunkOf(row).bearing[row & kOffsetMask]; }
+    float elevation(int row) const { return chunkOf(row).elevation[row & kOffsetMask]; }
+    // Plan-view position in metres east and north of the radar.
+    float east(int row) const { return chunkOf(row).east[row & kOffsetMask]; }
+    float north(int row) const { return chunkOf(row).north[row & kOffsetMask]; }
+    int channel(int row) const { return chunkOf(row).channel[row & kOffsetMask]; }
+    // Newest timestamp appended since the last clear, or 0 when empty.
+    double latestTimestamp() const { return latest_timestamp_; }
+    // Same for one channel; 0 before it has any rows.
+    double latestTimestamp(int channel) const
+    {
+        const bool held = channel >= 0 && channel < latest_by_channel_.size() &&
+                          latest_by_channel_[channel] > -std::numeric_limits<double>::infinity();
+        return held ? latest_by_channel_[channel] : 0.0;
+    }
+    // One past the highest channel appended since the last clear.
+    int channelCount() const { return latest_by_channel_.size(); }
+    // Accepts each channel's last `windowSeconds` by its own newest timestamp (0: all).
+    Filter windowFilter(double windowSeconds) const;
+
+    // Closest accepted row within `radius_m` of `point_m`, or -1.
+    int nearest(const QPointF& point_m, float radius_m, const Filter& filter = {}) const;
+    // Accepted rows whose plan-view position lies inside `area_m`, ascending.
+    QVector<int> rowsIn(const QRectF& area_m, const Filter& filter = {}) const;
+    // Accepted rows, ascending.
+    QVector<int> rowsMatching(const Filter& filter, int firstRow = 0) const;
+
+    // Calls `fn(row)` for accepted rows inside `area_m`, grouped by chunk and grid cell.
+    template <typename Fn>
+    void forEachIn(const QRectF& area_m, Fn&& fn, const Filter& filter = {}) const
+    {
+        const QRectF area = area_m.normalized();
+        const QRect cells = cellRange(area);
+        const double earliest = filter.earliestFrom(channelCount());
+        for (size_t c = 0; c < chunks_.size(); ++c) {
+            const Chunk& chunk = *chunks_[c];
+            if (!chunk.mayMatch(filter, earliest) || !chunk.mayOverlap(area)) {
+                continue;
+            }
+            const int base = static_cast<int>(c) << kChunkShift;
+            auto visit = [&](int offset) {
+                if (area.contains(chunk.east[offset], chunk.north[offset]) &&
+                    filter.accepts(chunk.timestamp[offset], chunk.snr[offset], chunk.channel[offset])) {
+                    fn(base + offset);
+                }
+            };
+            if (!chunk.indexed) {
+                for (int offset = 0; offset < chunk.count; ++offset) {
+                    visit(offset);
+                }
+                continue;
+            }
+            // A row of grid cells is one contiguous run of keys in the sorted index.
+            const quint16* keys = chunk.cell_key.data();
+            for (int cy = cells.top(); cy <= cells.bottom(); ++cy) {
+                const auto begin = std::lower_bound(keys, keys + chunk.count, cy * kGridCells + cells.left());
+                const auto end = std::upper_bound(begin, keys + chunk.count, cy * kGridCells + cells.right());
+                for (auto key = begin; key != end; ++key) {
+                    visit(chunk.by_cell[key - keys]);
+                }
+            }
+        }
+    }
+
+    // Calls `fn(row)` for accepted rows from `firstRow` on, in ascending row order.
+    template <typename Fn>
+    void forEachMatching(const Filter& filter, Fn&& fn, int firstRow = 0) const
+    {
+        const double earliest = filter.earliestFrom(channelCount());
+        for (size_t c = qMax(0, firstRow) >> kChunkShift; c < chunks_.size(); ++c) {
+            const Chunk& chunk = *chunks_[c];
+            if (!chunk.mayMatch(filter, earliest)) {
+                continue;
+            }
+            const int base = static_cast<int>(c) << kChunkShift;
+            int begin = qMax(0, firstRow - base);
+            int end = chunk.count;
+            // Most chunks arrive in time order, so the window bounds are binary searches.
+            if (chunk.time_ordered) {
+                const double* times = chunk.timestamp.data();
+                begin = static_cast<int>(std::lower_bound(times + begin, times + end, earliest) - times);
+                end = static_cast<int>(std::upper_bound(times + begin, times + end, filter.to_time) - times);
+            }
+            for (int offset = begin; offset < end; ++offset) {
+                if (filter.accepts(chunk.timestamp[offset], chunk.snr[offset], chunk.channel[offset])) {
+                    fn(base + offset);
+                }
+            }
+        }
+    }
+
+signals:
+    // Rows [first, last] were appended.
+    void rowsAppended(int first, int last);
+    // The oldest `count` rows were dropped; remaining rows shifted down by `count`.
+    void rowsEvicted(int count);
+    void cleared();
+
+private:
+    static constexpr int kOffsetMask = kChunkRows - 1;
+
+    struct Chunk
+    {
+        std::array<double, kChunkRows> timestamp;
+        std::array<float, kChunkRows> range;
+        std::array<float, kChunkRows> doppler;
+        std::array<float, kChunkRows> snr;
+        std::array<float, kChunkRows> bearing;
+        std::array<float, kChunkRows> elevation;
+        std::array<float, kChunkRows> east;
+        std::array<float, kChunkRows> north;
+        // Grid cell of each row while the chunk fills; once it is full, the keys are
+        // sorted and by_cell holds the matching row offsets (ascending within a cell).
+        std::array<quint16, kChunkRows> cell_key;
+        std::array<quint16, kChunkRows> by_cell;
+        std::array<quint8, kChunkRows> channel;
+        int count = 0;
+        bool indexed = false;
+        bool time_ordered = true;
+        double min_time = 0.0;
+        double max_time = 0.0;
+        float max_snr = 0.0f;
+        // Bit c is set when the chunk holds rows from channel c.
+        quint64 channels = 0;
+        // Plan-view bounding box of the rows.
+        float min_east = 0.0f;
+        float max_east = 0.0f;
+        float min_north = 0.0f;
+        float max_north = 0.0f;
+
+        void reset();
+        void add(const FrameFormat::DetectionRecord& record, int channel);
+        void buildIndex();
+        // `earliest` is filter.earliestFrom() for the store's channels.
+        bool mayMatch(const Filter& filter, double earliest) const
+        {
+            return count > 0 && max_time >= earliest && min_time <= filter.to_time && max_snr >= filter.min_snr &&
+                   (filter.channel < 0 || (filter.channel < kMaxChannels && (channels >> filter.channel) & 1u));
+        }
+        bool mayOverlap(const QRectF& area) const
+        {
+            // Inclusive on every edge, like the per-row contains() test.
+            return min_east <= area.right() && max_east >= area.left() && min_north <= area.bottom() &&
+                   max_north >= area.top();
+        }
+    };
+
+    static int cellOf(float metres);
+    QRect cellRange(const QRectF& area_m) const;
+    const Chunk& chunkOf(int row) const { return *chunks_[row >> kChunkShift]; }
+    int evictOldest();
+
+    int max_chunks_;
+    int size_ = 0;
+    qint64 first_id_ = 0;
+    double latest_timestamp_ = 0.0;
+    // Newest timestamp per channel; -infinity for channels with no rows yet.
+    QVector<double> latest_by_channel_;
+    // Oldest first; every chunk but the last is full, so row >> kChunkShift finds its chunk.
+    std::deque<std::unique_ptr<Chunk>> chunks_;
+    // The last evicted chunk, reused for the next one instead of reallocating.
+    std::unique_ptr<Chunk> spare_;
+};
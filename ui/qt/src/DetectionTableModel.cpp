@@ -0,0 +1,253 @@
+#include "DetectionTableModel.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+constexpr int kFetchBatch = 256;
+} // namespace
+
+DetectionTableModel::DetectionTableModel(const DetectionStore* store, QObject* parent)
+    : QAbstractTableModel(parent)
+    , store_(store)
+{
+    connect(store_, &DetectionStore::rowsAppended, this, &DetectionTableModel::onRowsAppended);
+    connect(store_, &DetectionStore::rowsEvicted, this, &DetectionTableModel::onRowsEvicted);
+    connect(store_, &DetectionStore::cleared, this, &DetectionTableModel::onCleared);
+}
+
+int DetectionTableModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : loaded_;
+}
+
+int DetectionTableModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant DetectionTableModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= loaded_) {
+        return {};
+    }
+    const int row = storeRow(index.row());
+    if (row < 0) {
+        return {};
+    }
+    if (role == Qt::TextAlignmentRole) {
+        return QVariant::fromValue((index.column() == ChannelColumn ? Qt::AlignLeft : Qt::AlignRight) |
+                                   Qt::AlignVCenter);
+    }
+    if (role != Qt::DisplayRole) {
+        return {};
+    }
+
+    switch (index.column()) {
+    case ChannelColumn: {
+        const int channel = store_->channel(row);
+        return channel < channel_names_.size() ? channel_names_[channel] : QString::number(channel);
+    }
+    case TimeColumn:
+        return QString::number(store_->timestamp(row), 'f', 3);
+    case RangeColumn:
+        return QString::number(store_->range(row), 'f', 1);
+    case DopplerColumn:
+        return QString::number(store_->doppler(row), 'f', 2);
+    case SnrColumn:
+        return QString::number(store_->snr(row), 'f', 1);
+    case BearingColumn:
+        return QString::number(store_->bearing(row), 'f', 1);
+    case ElevationColumn:
+        return QString::number(store_->elevation(row), 'f', 1);
+    default:
+        return {};
+    }
+}
+
+QVariant DetectionTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    switch (section) {
+    case ChannelColumn:
+        return tr("Channel");
+    case TimeColumn:
+        return tr("Time (s)");
+    case RangeColumn:
+        return tr("Range (m)");
+    case DopplerColumn:
+        return tr("Doppler (m/s)");
+    case SnrColumn:
+        return tr("SNR (dB)");
+    case BearingColumn:
+        return tr("Bearing (deg)");
+    case ElevationColumn:
+        return tr("Elevation (deg)");
+    default:
+        return {};
+    }
+}
+
+bool DetectionTableModel::canFetchMore(const QModelIndex& parent) const
+{
+    return !parent.isValid() && loaded_ < available();
+}
+
+void DetectionTableModel::fetchMore(const QModelIndex& parent)
+{
+    if (parent.isValid()) {
+        return;
+    }
+    const int count = qMin(kFetchBatch, available() - loaded_);
+    if (count <= 0) {
+        return;
+    }
+    beginInsertRows(QModelIndex(), loaded_, loaded_ + count - 1);
+    loaded_ += count;
+    endInsertRows();
+}
+
+void DetectionTableModel::setChannelNames(const QStringList& names)
+{
+    channel_names_ = names;
+    if (loaded_ > 0) {
+        emit dataChanged(index(0, ChannelColumn), index(loaded_ - 1, ChannelColumn), {Qt::DisplayRole});
+    }
+}
+
+void DetectionTableModel::setFilter(double windowSeconds, float minSnr, int channel)
+{
+    beginResetModel();
+    window_s_ = qMax(0.0, windowSeconds);
+    min_snr_ = minSnr;
+    channel_ = channel < DetectionStore::kMaxChannels ? channel : -1;
+    loaded_ = 0;
+    ids_.clear();
+    if (isFiltered()) {
+        store_->forEachMatching(currentFilter(), [this](int row) { ids_.append(store_->idAt(row)); });
+    }
+    endResetModel();
+}
+
+DetectionStore::Filter DetectionTableModel::currentFilter() const
+{
+    DetectionStore::Filter filter = store_->windowFilter(window_s_);
+    filter.min_snr = min_snr_;
+    filter.channel = channel_;
+    return filter;
+}
+
+int DetectionTableModel::storeRow(int tableRow) const
+{
+    if (!isFiltered()) {
+        return tableRow;
+    }
+    return tableRow >= 0 && tableRow < ids_.size() ? store_->rowOf(ids_[tableRow]) : -1;
+}
+
+int DetectionTableModel::tableRow(int storeRow) const
+{
+    if (!isFiltered()) {
+        return storeRow;
+    }
+    const qint64 id = store_->idAt(storeRow);
+    const auto it = std::lower_bound(ids_.cbegin(), ids_.cend(), id);
+    return it != ids_.cend() && *it == id ? static_cast<int>(it - ids_.cbegin()) : -1;
+}
+
+void DetectionTableModel::onRowsAppended(int first, int)
+{
+    // Keep following the tail while the view has everything loaded; otherwise the
+    // rows wait until the view scrolls far enough to ask for them.
+    if (!isFiltered()) {
+        if (first == loaded_) {
+            fetchMore(QModelIndex());
+        }
+        return;
+    }
+    dropExpired();
+    const bool following = loaded_ == ids_.size();
+    store_->forEachMatching(
+        currentFilter(), [this](int row) { ids_.append(store_->idAt(row)); }, first);
+    if (following) {
+        fetchMore(QModelIndex());
+    }
+}
+
+void DetectionTableModel::dropExpired()
+{
+    if (window_s_ <= 0.0) {
+        return;
+    }
+    // Each channel's rows arrive in time order, so its expired ones precede the rest of its
+    // rows; channels interleave, though, so the scan runs until every channel has reached
+    // a row still inside the window. Expired runs are removed newest first, keeping the
+    // earlier runs' positions valid.
+    const DetectionStore::Filter filter = store_->windowFilter(window_s_);
+    const int channels = store_->channelCount();
+    quint64 all = channels >= DetectionStore::kMaxChannels ? ~quint64(0) : (quint64(1) << channels) - 1;
+    if (channel_ >= 0) {
+        all = quint64(1) << channel_;
+    }
+    quint64 current = 0;
+    QVector<std::pair<int, int>> runs;
+    for (int i = 0; i < ids_.size() && current != all; ++i) {
+        const int row = store_->rowOf(ids_[i]);
+        const int channel = store_->channel(row);
+        if (store_->timestamp(row) >= filter.fromTime(channel)) {
+            current |= quint64(1) << channel;
+        } else if (!runs.isEmpty() && runs.last().first + runs.last().second == i) {
+            ++runs.last().second;
+        } else {
+            runs.append({i, 1});
+        }
+    }
+    for (auto run = runs.crbegin(); run != runs.crend(); ++run) {
+        dropIds(run->first, run->second);
+    }
+}
+
+void DetectionTableModel::dropIds(int first, int count)
+{
+    if (count <= 0) {
+        return;
+    }
+    const int removed = qBound(0, loaded_ - first, count);
+    if (removed > 0) {
+        beginRemoveRows(QModelIndex(), first, first + removed - 1);
+    }
+    ids_.remove(first, count);
+    loaded_ -= removed;
+    if (removed > 0) {
+        endRemoveRows();
+    }
+}
+
+void DetectionTableModel::onRowsEvicted(int count)
+{
+    if (isFiltered()) {
+        // Evicted ids are the smallest, so they too form a prefix.
+        const auto kept =
+            std::find_if(ids_.cbegin(), ids_.cend(), [this](qint64 id) { return store_->rowOf(id) >= 0; });
+        dropIds(0, static_cast<int>(kept - ids_.cbegin()));
+        return;
+    }
+    const int removed = qMin(count, loaded_);
+    if (removed == 0) {
+        return;
+    }
+    beginRemoveRows(QModelIndex(), 0, removed - 1);
+    loaded_ -= removed;
+    endRemoveRows();
+}
+
+void DetectionTableModel::onCleared()
+{
+    beginResetModel();
+    loaded_ = 0;
+    ids_.clear();
+    endResetModel();
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "DetectionStore.h"
+
+#include <QAbstractTableModel>
+#include <QStringList>
+#include <QVector>
+
+// Read-only table over a DetectionStore. Rows are exposed in batches through
+// canFetchMore()/fetchMore() so the view never lays out the whole history at once.
+//
+// With a filter set, the table lists only the matching rows, tracked by store id. It
+// starts from one store query, then extends as frames arrive and drops rows from its
+// front as the time window slides past them or the store evicts them. Each channel's window
+// follows that channel's own newest detection.
+class DetectionTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column
+    {
+        ChannelColumn,
+        TimeColumn,
+        RangeColumn,
+        DopplerColumn,
+        SnrColumn,
+        BearingColumn,
+        ElevationColumn,
+        ColumnCount
+    };
+
+    explicit DetectionTableModel(const DetectionStore* store, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+
+    // Names shown in the channel column, indexed by the store's channel numbers.
+    void setChannelNames(const QStringList& names);
+    // Show only the last `windowSeconds` of detections (0: all) at or above `minSnr` dB,
+    // from `channel` alone or, with -1, from every channel.
+    void setFilter(double windowSeconds, float minSnr, int channel = -1);
+    // Store row shown at `tableRow`, and the table row showing `storeRow` (-1 if hidden).
+    int storeRow(int tableRow) const;
+    int tableRow(int storeRow) const;
+
+private:
+    bool isFiltered() const
+    {
+        return window_s_ > 0.0 || min_snr_ > -std::numeric_limits<float>::infinity() || channel_ >= 0;
+    }
+    DetectionStore::Filter currentFilter() const;
+    int available() const { return isFiltered() ? ids_.size() : store_->size(); }
+    // Removes `count` filtered ids from `first` on, and the table rows showing them.
+    void dropIds(int first, int count);
+    void dropExpired();
+
+    void onRowsAppended(int first, int last);
+    void onRowsEvicted(int count);
+    void onCleared();
+
+    const DetectionStore* store_;
+    // Rows currently published to views; the store may hold more.
+    int loaded_ = 0;
+    double window_s_ = 0.0;
+    float min_snr_ = -std::numeric_limits<float>::infinity();
+    int channel_ = -1;
+    QStringList channel_names_;
+    // Matching store ids, ascending, while a filter is set.
+    QVector<qint64> ids_;
+};
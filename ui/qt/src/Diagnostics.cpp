@@ -0,0 +1,241 @@
+#include "Diagnostics.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QtAlgorithms>
+
+#include <chrono>
+
+void LatencyHistogram::record(qint64 micros)
+{
+    const quint64 value = micros > 0 ? static_cast<quint64>(micros) : 0;
+    buckets_[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    sum_us_.fetch_add(value, std::memory_order_relaxed);
+    quint64 seen = max_us_.load(std::memory_order_relaxed);
+    while (value > seen && !max_us_.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogram::Summary LatencyHistogram::summary() const
+{
+    // Snapshot the buckets first; concurrent records may land mid-scan, which only skews
+    // the percentiles by the handful of samples recorded meanwhile.
+    const Snapshot counts = snapshot();
+    return summarize(counts.buckets, counts.sum_us, static_cast<qint64>(max_us_.load(std::memory_order_relaxed)));
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+{
+    Snapshot snapshot;
+    for (int i = 0; i < kBuckets; ++i) {
+        snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+    snapshot.sum_us = sum_us_.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+LatencyHistogram::Summary LatencyHistogram::summaryBetween(const Snapshot& earlier, const Snapshot& later)
+{
+    // A reset in between leaves later below earlier; count those buckets from zero.
+    std::array<quint64, kBuckets> counts;
+    qint64 max_us = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+        counts[i] = later.buckets[i] >= earlier.buckets[i] ? later.buckets[i] - earlier.buckets[i] : later.buckets[i];
+        if (counts[i] > 0) {
+            max_us = bucketMidpoint(i);
+        }
+    }
+    const quint64 sum_us = later.sum_us >= earlier.sum_us ? later.sum_us - earlier.sum_us : later.sum_us;
+    return summarize(counts, sum_us, max_us);
+}
+
+LatencyHistogram::Summary LatencyHistogram::summarize(const std::array<quint64, kBuckets>& counts, quint64 sum_us,
+                                                      qint64 max_us)
+{
+    quint64 total = 0;
+    for (const quint64 count : counts) {
+        total += count;
+    }
+
+    Summary summary;
+    summary.count = total;
+    summary.max_us = max_us;
+    if (total == 0) {
+        return summary;
+    }
+    summary.mean_us = static_cast<qint64>(sum_us / total);
+
+    const auto percentile = [&](double fraction) {
+        const quint64 rank = qMax<quint64>(1, static_cast<quint64>(fraction * total + 0.5));
+        quint64 seen = 0;
+        for (int i = 0; i < kBuckets; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return qMin(bucketMidpoint(i), summary.max_us);
+            }
+        }
+        return summary.max_us;
+    };
+    summary.p50_us = percentile(0.50);
+    summary.p90_us = percentile(0.90);
+    summary.p99_us = percentile(0.99);
+    return summary;
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    sum_us_.store(0, std::memory_order_relaxed);
+    max_us_.store(0, std::memory_order_relaxed);
+}
+
+int LatencyHistogram::bucketOf(quint64 micros)
+{
+    // Values below kSubBuckets get exact buckets; above that each power of two is split
+    // into kSubBuckets linear steps.
+    if (micros < kSubBuckets) {
+        return static_cast<int>(micros);
+    }
+    const int octave = 63 - qCountLeadingZeroBits(micros);
+    const int sub = static_cast<int>((micros >> (octave - 2)) & (kSubBuckets - 1));
+    return qMin(kBuckets - 1, kSubBuckets + (octave - 2) * kSubBuckets + sub);
+}
+
+qint64 LatencyHistogram::bucketMidpoint(int bucket)
+{
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+    const int octave = (bucket - kSubBuckets) / kSubBuckets + 2;
+    const int sub = (bucket - kSubBuckets) % kSubBuckets;
+    const qint64 low = static_cast<qint64>(kSubBuckets + sub) << (octave - 2);
+    const qint64 width = qint64(1) << (octave - 2);
+    return low + width / 2;
+}
+
+Diagnostics& Diagnostics::instance()
+{
+    static Diagnostics diagnostics;
+    return diagnostics;
+}
+
+qint64 Diagnostics::nowUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+QString Diagnostics::stageName(Stage stage)
+{
+    switch (stage) {
+    case Stage::FirstByte:
+        return QStringLiteral("first_byte");
+    case Stage::Transfer:
+        return QStringLiteral("transfer");
+    case Stage::Decode:
+        return QStringLiteral("decode");
+    case Stage::Dispatch:
+        return QStringLiteral("dispatch");
+    case Stage::Paint:
+        return QStringLiteral("paint");
+    case Stage::EndToEnd:
+        return QStringLiteral("end_to_end");
+    case Stage::Count:
+        break;
+    }
+    return QString();
+}
+
+void Diagnostics::record(Stage stage, qint64 micros)
+{
+    stages_[static_cast<int>(stage)].record(micros);
+}
+
+LatencyHistogram::Summary Diagnostics::summary(Stage stage) const
+{
+    return stages_[static_cast<int>(stage)].summary();
+}
+
+LatencyHistogram::Snapshot Diagnostics::snapshot(Stage stage) const
+{
+    return stages_[static_cast<int>(stage)].snapshot();
+}
+
+void Diagnostics::addFrameBufferCheckout(int inUse, int capacity, bool reused, bool exhausted)
+{
+    buffer_checkouts_.fetch_add(1, std::memory_order_relaxed);
+    if (reused) {
+        buffers_reused_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (exhausted) {
+        buffers_exhausted_.fetch_add(1, std::memory_order_relaxed);
+    }
+    buffer_capacity_.store(capacity, std::memory_order_relaxed);
+    int high = buffer_high_water_.load(std::memory_order_relaxed);
+    while (inUse > high && !buffer_high_water_.compare_exchange_weak(high, inUse, std::memory_order_relaxed)) {
+    }
+}
+
+Diagnostics::FrameBufferStats Diagnostics::frameBuffers() const
+{
+    FrameBufferStats stats;
+    stats.checkouts = buffer_checkouts_.load(std::memory_order_relaxed);
+    stats.reused = buffers_reused_.load(std::memory_order_relaxed);
+    stats.exhausted = buffers_exhausted_.load(std::memory_order_relaxed);
+    stats.high_water = buffer_high_water_.load(std::memory_order_relaxed);
+    stats.capacity = buffer_capacity_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+QJsonObject Diagnostics::toJson() const
+{
+    QJsonObject stages;
+    for (int i = 0; i < static_cast<int>(Stage::Count); ++i) {
+        const auto stage = static_cast<Stage>(i);
+        const auto s = summary(stage);
+        stages.insert(stageName(stage), QJsonObject{{QStringLiteral("count"), static_cast<qint64>(s.count)},
+                                                    {QStringLiteral("p50_us"), s.p50_us},
+                                                    {QStringLiteral("p90_us"), s.p90_us},
+                                                    {QStringLiteral("p99_us"), s.p99_us},
+                                                    {QStringLiteral("max_us"), s.max_us},
+                                                    {QStringLiteral("mean_us"), s.mean_us}});
+    }
+    const auto pool = frameBuffers();
+    const QJsonObject buffers{{QStringLiteral("checkouts"), static_cast<qint64>(pool.checkouts)},
+                              {QStringLiteral("reused"), static_cast<qint64>(pool.reused)},
+                              {QStringLiteral("exhausted"), static_cast<qint64>(pool.exhausted)},
+                              {QStringLiteral("high_water"), pool.high_water},
+                              {QStringLiteral("capacity"), pool.capacity}};
+    return QJsonObject{{QStringLiteral("frames"), static_cast<qint64>(frames())},
+                       {QStringLiteral("bytes"), static_cast<qint64>(bytes())},
+                       {QStringLiteral("coalesced_repaints"), static_cast<qint64>(coalescedRepaints())},
+                       {QStringLiteral("dropped_frames"), static_cast<qint64>(droppedFrames())},
+                       {QStringLiteral("frame_buffers"), buffers},
+                       {QStringLiteral("stages"), stages}};
+}
+
+bool Diagnostics::writeJson(const QString& path) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(QJsonDocument(toJson()).toJson()) >= 0;
+}
+
+void Diagnostics::reset()
+{
+    for (auto& stage : stages_) {
+        stage.reset();
+    }
+    frames_.store(0, std::memory_order_relaxed);
+    bytes_.store(0, std::memory_order_relaxed);
+    coalesced_repaints_.store(0, std::memory_order_relaxed);
+    dropped_frames_.store(0, std::memory_order_relaxed);
+    buffer_checkouts_.store(0, std::memory_order_relaxed);
+    buffers_reused_.store(0, std::memory_order_relaxed);
+    buffers_exhausted_.store(0, std::memory_order_relaxed);
+    buffer_high_water_.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+
+#include <array>
+#include <atomic>
+
+// Lock-free latency histogram: log-linear buckets (four per power of two, in
+// microseconds) updated with relaxed atomics, so the decoder thread and the GUI
+// thread can record without contending on a mutex. Percentiles are accurate to
+// roughly one bucket (about 12%).
+class LatencyHistogram
+{
+public:
+    struct Summary
+    {
+        quint64 count = 0;
+        qint64 p50_us = 0;
+        qint64 p90_us = 0;
+        qint64 p99_us = 0;
+        qint64 max_us = 0;
+        qint64 mean_us = 0;
+    };
+
+    static constexpr int kSubBuckets = 4;
+    static constexpr int kBuckets = 128;
+
+    // Bucket counts at one instant. Buckets only ever grow, so the difference between two
+    // snapshots is the histogram of the samples recorded in between.
+    struct Snapshot
+    {
+        std::array<quint64, kBuckets> buckets{};
+        quint64 sum_us = 0;
+    };
+
+    void record(qint64 micros);
+    Summary summary() const;
+    Snapshot snapshot() const;
+    // Samples recorded after `earlier` up to `later`; max_us is the top occupied bucket.
+    static Summary summaryBetween(const Snapshot& earlier, const Snapshot& later);
+    void reset();
+
+private:
+    static int bucketOf(quint64 micros);
+    static qint64 bucketMidpoint(int bucket);
+    static Summary summarize(const std::array<quint64, kBuckets>& counts, quint64 sum_us, qint64 max_us);
+
+    std::array<std::atomic<quint64>, kBuckets> buckets_{};
+    std::atomic<quint64> sum_us_{0};
+    std::atomic<quint64> max_us_{0};
+};
+
+// Process-wide client pipeline timings, from request/chunk arrival to the painted frame.
+class Diagnostics
+{
+public:
+    enum class Stage
+    {
+        // Poll request sent -> reply headers received.
+        FirstByte,
+        // Reply headers -> body complete.
+        Transfer,
+        // Body or stream chunk received -> FrameSnapshot built on the decoder thread.
+        Decode,
+        // Snapshot built -> dataReady emitted on the GUI thread.
+        Dispatch,
+        // dataReady -> profile graph finished painting the frame.
+        Paint,
+        // Poll sent (or stream chunk received) -> frame painted.
+        EndToEnd,
+        Count
+    };
+
+    // FramePool checkouts summed over every decoder; high_water is the most slots any one
+    // pool needed at once, so a value above `capacity` means that pool ran dry.
+    struct FrameBufferStats
+    {
+        quint64 checkouts = 0;
+        quint64 reused = 0;
+        quint64 exhausted = 0;
+        int high_water = 0;
+        int capacity = 0;
+    };
+
+    static Diagnostics& instance();
+    // Monotonic microseconds; comparable across threads.
+    static qint64 nowUs();
+    static QString stageName(Stage stage);
+
+    void record(Stage stage, qint64 micros);
+    LatencyHistogram::Summary summary(Stage stage) const;
+    LatencyHistogram::Snapshot snapshot(Stage stage) const;
+    void addFrame() { frames_.fetch_add(1, std::memory_order_relaxed); }
+    void addBytes(qint64 bytes) { bytes_.fetch_add(static_cast<quint64>(bytes), std::memory_order_relaxed); }
+    quint64 frames() const { return frames_.load(std::memory_order_relaxed); }
+    quint64 bytes() const { return bytes_.load(std::memory_order_relaxed); }
+    // Repaint requests folded into one already waiting for the display tick, see
+    // RenderScheduler. The data is not lost: widgets keep their newest snapshot and the
+    // waterfall keeps every row, so this counts saved paints, not skipped frames.
+    void addCoalescedRepaint() { coalesced_repaints_.fetch_add(1, std::memory_order_relaxed); }
+    quint64 coalescedRepaints() const { return coalesced_repaints_.load(std::memory_order_relaxed); }
+    // Frames the bridges published that never reached the widgets, over every channel.
+    void addDroppedFrames(quint64 count) { dropped_frames_.fetch_add(count, std::memory_order_relaxed); }
+    quint64 droppedFrames() const { return dropped_frames_.load(std::memory_order_relaxed); }
+    // `inUse` counts the slots referenced at checkout, including the one requested.
+    void addFrameBufferCheckout(int inUse, int capacity, bool reused, bool exhausted);
+    FrameBufferStats frameBuffers() const;
+
+    QJsonObject toJson() const;
+    bool writeJson(const QString& path) const;
+    void reset();
+
+private:
+    Diagnostics() = default;
+
+    std::array<LatencyHistogram, static_cast<int>(Stage::Count)> stages_;
+    std::atomic<quint64> frames_{0};
+    std::atomic<quint64> bytes_{0};
+    std::atomic<quint64> coalesced_repaints_{0};
+    std::atomic<quint64> dropped_frames_{0};
+    std::atomic<quint64> buffer_checkouts_{0};
+    std::atomic<quint64> buffers_reused_{0};
+    std::atomic<quint64> buffers_exhausted_{0};
+    std::atomic<int> buffer_high_water_{0};
+    std::atomic<int> buffer_capacity_{0};
+};
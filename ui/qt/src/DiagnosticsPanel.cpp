@@ -0,0 +1,116 @@
+#include "DiagnosticsPanel.h"
+
+#include "Diagnostics.h"
+
+#include <QBoxLayout>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QTimer>
+
+namespace
+{
+constexpr int kRefreshMs = 1000;
+constexpr int kStageCount = static_cast<int>(Diagnostics::Stage::Count);
+
+QString formatMs(qint64 micros)
+{
+    return QString::number(micros / 1000.0, 'f', micros < 10000 ? 2 : 1);
+}
+} // namespace
+
+DiagnosticsPanel::DiagnosticsPanel(QWidget* parent)
+    : QGroupBox(tr("Diagnostics"), parent)
+    , table_(new QTableWidget(kStageCount, 5, this))
+    , rates_label_(new QLabel(this))
+{
+    table_->setHorizontalHeaderLabels({tr("Samples"), tr("p50 (ms)"), tr("p99 (ms)"), tr("Max (ms)"), tr("Mean (ms)")});
+    QStringList stages;
+    for (int i = 0; i < kStageCount; ++i) {
+        stages.append(Diagnostics::stageName(static_cast<Diagnostics::Stage>(i)));
+        for (int column = 0; column < table_->columnCount(); ++column) {
+            auto* item = new QTableWidgetItem;
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            table_->setItem(i, column, item);
+        }
+    }
+    table_->setVerticalHeaderLabels(stages);
+    table_->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    table_->verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table_->setSelectionMode(QAbstractItemView::NoSelection);
+    table_->setFixedHeight(table_->horizontalHeader()->sizeHint().height() +
+                           kStageCount * table_->verticalHeader()->defaultSectionSize() + 4);
+
+    auto* resetButton = new QPushButton(tr("Reset"), this);
+    auto* saveButton = new QPushButton(tr("Save JSON..."), this);
+    auto* footer = new QHBoxLayout();
+    footer->addWidget(rates_label_, 1);
+    footer->addWidget(resetButton);
+    footer->addWidget(saveButton);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addWidget(table_);
+    layout->addLayout(footer);
+
+    connect(resetButton, &QPushButton::clicked, this, &DiagnosticsPanel::onReset);
+    connect(saveButton, &QPushButton::clicked, this, &DiagnosticsPanel::onSaveJson);
+    auto* timer = new QTimer(this);
+    connect(timer, &QTimer::timeout, this, &DiagnosticsPanel::refresh);
+    timer->start(kRefreshMs);
+    refresh();
+}
+
+void DiagnosticsPanel::refresh()
+{
+    // Skip the table work entirely while the panel is hidden.
+    const auto& diagnostics = Diagnostics::instance();
+    const qint64 now = Diagnostics::nowUs();
+    const quint64 frames = diagnostics.frames();
+    const quint64 bytes = diagnostics.bytes();
+    if (isVisible()) {
+        for (int i = 0; i < kStageCount; ++i) {
+            const auto s = diagnostics.summary(static_cast<Diagnostics::Stage>(i));
+            table_->item(i, 0)->setText(QString::number(s.count));
+            table_->item(i, 1)->setText(formatMs(s.p50_us));
+            table_->item(i, 2)->setText(formatMs(s.p99_us));
+            table_->item(i, 3)->setText(formatMs(s.max_us));
+            table_->item(i, 4)->setText(formatMs(s.mean_us));
+        }
+        if (last_refresh_us_ != 0 && now > last_refresh_us_ && frames >= last_frames_) {
+            const double seconds = (now - last_refresh_us_) / 1e6;
+            const auto buffers = diagnostics.frameBuffers();
+            rates_label_->setText(tr("%1 frames/s | %2 KiB/s | %3 repaints coalesced | frame buffers %4/%5 peak, "
+                                     "%6 exhausted")
+                                      .arg((frames - last_frames_) / seconds, 0, 'f', 1)
+                                      .arg((bytes - last_bytes_) / seconds / 1024.0, 0, 'f', 1)
+                                      .arg(diagnostics.coalescedRepaints())
+                                      .arg(buffers.high_water)
+                                      .arg(buffers.capacity)
+                                      .arg(buffers.exhausted));
+        }
+    }
+    last_frames_ = frames;
+    last_bytes_ = bytes;
+    last_refresh_us_ = now;
+}
+
+void DiagnosticsPanel::onReset()
+{
+    Diagnostics::instance().reset();
+    last_frames_ = 0;
+    last_bytes_ = 0;
+    refresh();
+}
+
+void DiagnosticsPanel::onSaveJson()
+{
+    const QString path = QFileDialog::getSaveFileName(this, tr("Save Diagnostics"), QStringLiteral("diagnostics.json"),
+                                                      tr("JSON (*.json)"));
+    if (!path.isEmpty() && !Diagnostics::instance().writeJson(path)) {
+        QMessageBox::warning(this, tr("Save Diagnostics"), tr("Cannot write %1").arg(path));
+    }
+}
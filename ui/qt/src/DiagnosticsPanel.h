@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QGroupBox>
+
+class QLabel;
+class QTableWidget;
+
+// Live view of the Diagnostics registry: per-stage p50/p99/max, frame/byte rates and
+// frame buffer pool use, refreshed once a second, with reset and JSON export.
+class DiagnosticsPanel : public QGroupBox
+{
+    Q_OBJECT
+
+public:
+    explicit DiagnosticsPanel(QWidget* parent = nullptr);
+
+private:
+    void refresh();
+    void onSaveJson();
+    void onReset();
+
+    QTableWidget* table_;
+    QLabel* rates_label_;
+    quint64 last_frames_ = 0;
+    quint64 last_bytes_ = 0;
+    qint64 last_refresh_us_ = 0;
+};
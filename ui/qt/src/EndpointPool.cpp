@@ -0,0 +1,114 @@
+#include "EndpointPool.h"
+
+#include "FrameDecoder.h"
+
+#include <QNetworkReply>
+#include <QThread>
+#include <QUrl>
+#include <algorithm>
+
+namespace
+{
+constexpr int kMaxDecoderThreads = 4;
+} // namespace
+
+EndpointPool::EndpointPool(int decoderThreads, QObject* parent)
+    : QObject(parent)
+{
+    const int count = decoderThreads > 0 ? decoderThreads
+                                         : qBound(1, QThread::idealThreadCount(), kMaxDecoderThreads);
+    for (int i = 0; i < count; ++i) {
+        auto* thread = new QThread(this);
+        thread->setObjectName(QStringLiteral("gmti-frame-decoder-%1").arg(i));
+        thread->start();
+        threads_.append(thread);
+    }
+}
+
+EndpointPool::~EndpointPool()
+{
+    // Decoders still alive belong to providers that outlive the pool; a finishing thread
+    // runs pending deferred deletes, so they are freed as their threads wind down.
+    for (const auto& decoder : decoders_) {
+        if (decoder) {
+            decoder->deleteLater();
+        }
+    }
+    for (QThread* thread : threads_) {
+        thread->quit();
+    }
+    for (QThread* thread : threads_) {
+        thread->wait();
+    }
+}
+
+QNetworkRequest EndpointPool::request(const QUrl& url, int timeoutMs) const
+{
+    QNetworkRequest request(url);
+    // Leaving Accept-Encoding unset lets Qt advertise gzip and inflate replies itself.
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+    if (http2_direct_) {
+        request.setAttribute(QNetworkRequest::Http2DirectAttribute, true);
+    }
+    request.setTransferTimeout(timeoutMs);
+    return request;
+}
+
+QNetworkReply* EndpointPool::get(const QNetworkRequest& request)
+{
+    return track(manager_.get(request));
+}
+
+QNetworkReply* EndpointPool::post(const QNetworkRequest& request, const QByteArray& body)
+{
+    return track(manager_.post(request, body));
+}
+
+QNetworkReply* EndpointPool::post(const QNetworkRequest& request, QIODevice* body)
+{
+    return track(manager_.post(request, body));
+}
+
+QNetworkReply* EndpointPool::track(QNetworkReply* reply)
+{
+    ++stats_.requests;
+#if QT_VERSION >= QT_VERSION_CHECK(6, 3, 0)
+    // Only emitted when the reply needs a fresh socket, never for a reused connection.
+    connect(reply, &QNetworkReply::socketStartedConnecting, this, [this]() { ++stats_.connections; });
+#endif
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        if (reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool()) {
+            ++stats_.http2;
+        }
+        switch (reply->error()) {
+        case QNetworkReply::NoError:
+        case QNetworkReply::OperationCanceledError:
+            break;
+        case QNetworkReply::TimeoutError:
+            ++stats_.timeouts;
+            break;
+        default:
+            ++stats_.errors;
+            break;
+        }
+    });
+    return reply;
+}
+
+FrameDecoder* EndpointPool::createDecoder()
+{
+    decoders_.removeAll(nullptr);
+    QVector<int> load(threads_.size(), 0);
+    for (const auto& decoder : decoders_) {
+        const int index = threads_.indexOf(decoder->thread());
+        if (index >= 0) {
+            ++load[index];
+        }
+    }
+    const int target = static_cast<int>(std::min_element(load.cbegin(), load.cend()) - load.cbegin());
+
+    auto* decoder = new FrameDecoder(frame_buffers_);
+    decoder->moveToThread(threads_[target]);
+    decoders_.append(decoder);
+    return decoder;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "FramePool.h"
+
+#include <QByteArray>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+
+class FrameDecoder;
+class QIODevice;
+class QNetworkReply;
+class QThread;
+class QUrl;
+
+// Client-wide network layer and decoder threads. Every bridge request (channel polls and
+// streams, configurator and sweep submissions) goes through one QNetworkAccessManager,
+// whose per-host pools keep each bridge's traffic on a few keep-alive connections (or
+// one multiplexed HTTP/2 connection), with gzip negotiated and a transfer timeout set per
+// request. Decoder threads are shared the same way: channels are spread across a small
+// set, so one channel's large frames only ever delay the channels sharing its thread.
+class EndpointPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    // `decoderThreads` <= 0 picks one per core, capped at four.
+    explicit EndpointPool(int decoderThreads = 0, QObject* parent = nullptr);
+    ~EndpointPool() override;
+
+    // Connection reuse as seen by this client; `connections` counts TCP connects (Qt 6.3
+    // and later report them; older Qt leaves it 0), so requests - connections were served
+    // on an already open connection.
+    struct Statistics
+    {
+        quint64 requests = 0;
+        quint64 connections = 0;
+        quint64 http2 = 0;
+        quint64 timeouts = 0;
+        quint64 errors = 0;
+    };
+
+    static constexpr int kDefaultTimeoutMs = 5000;
+
+    // Sends HTTP/2 with prior knowledge (h2c) instead of HTTP/1.1 keep-alive. The bridge's
+    // server accepts both; proxies in between may not.
+    void setHttp2Direct(bool enabled) { http2_direct_ = enabled; }
+    // FramePool slots for decoders created from now on.
+    void setFrameBuffers(int count) { frame_buffers_ = count; }
+    // Request with the shared attributes; `timeoutMs` 0 disables the transfer timeout,
+    // which long-lived streams need.
+    QNetworkRequest request(const QUrl& url, int timeoutMs = kDefaultTimeoutMs) const;
+    QNetworkReply* get(const QNetworkRequest& request);
+    QNetworkReply* post(const QNetworkRequest& request, const QByteArray& body);
+    // `body` must stay open until the reply finishes; parent it to the reply to tie them.
+    QNetworkReply* post(const QNetworkRequest& request, QIODevice* body);
+    Statistics statistics() const { return stats_; }
+    // New decoder living on the decoder thread with the fewest channels.
+    FrameDecoder* createDecoder();
+    int decoderThreadCount() const { return threads_.size(); }
+
+private:
+    QNetworkReply* track(QNetworkReply* reply);
+
+    QNetworkAccessManager manager_;
+    bool http2_direct_ = false;
+    int frame_buffers_ = FramePool::kDefaultCapacity;
+    Statistics stats_;
+    QVector<QThread*> threads_;
+    QVector<QPointer<FrameDecoder>> decoders_;
+};
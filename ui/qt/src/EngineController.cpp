@@ -0,0 +1,219 @@
+#include "EngineController.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QHostAddress>
+#include <QProcessEnvironment>
+#include <QTcpSocket>
+
+namespace
+{
+constexpr int kProbeIntervalMs = 200;
+// SIGTERM grace period before the engine is killed outright.
+constexpr int kStopGraceMs = 2000;
+
+QString executableName()
+{
+#ifdef Q_OS_WIN
+    return QStringLiteral("simulator.exe");
+#else
+    return QStringLiteral("simulator");
+#endif
+}
+
+bool isExecutable(const QFileInfo& info)
+{
+    return info.isFile() && info.isExecutable();
+}
+} // namespace
+
+EngineController::EngineController(QObject* parent)
+    : QObject(parent)
+{
+    process_.setProcessChannelMode(QProcess::MergedChannels);
+    probe_timer_.setInterval(kProbeIntervalMs);
+    kill_timer_.setSingleShot(true);
+    kill_timer_.setInterval(kStopGraceMs);
+
+    connect(&process_, &QProcess::readyReadStandardOutput, this,
+            [this]() { emit outputReceived(process_.readAllStandardOutput()); });
+    connect(&process_, &QProcess::started, this, [this]() {
+        emit message(tr("Simulator process started; waiting for the bridge on port %1...").arg(bridge_port_),
+                     LogSink::Severity::Info);
+        probe_timer_.start();
+        probeBridge();
+    });
+    connect(&process_, &QProcess::errorOccurred, this, &EngineController::onProcessError);
+    connect(&process_, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this,
+            &EngineController::onProcessFinished);
+    connect(&probe_timer_, &QTimer::timeout, this, &EngineController::probeBridge);
+    connect(&kill_timer_, &QTimer::timeout, this, [this]() {
+        emit message(tr("Simulator did not exit after %1 ms; killing it.").arg(kStopGraceMs),
+                     LogSink::Severity::Warning);
+        process_.kill();
+    });
+}
+
+EngineController::~EngineController()
+{
+    // The window is going away; kill rather than wait so closing never stalls, and let
+    // QProcess reap the child.
+    process_.disconnect(this);
+    if (process_.state() != QProcess::NotRunning) {
+        process_.kill();
+    }
+}
+
+void EngineController::setWorkingDirectory(const QString& path)
+{
+    working_directory_ = path;
+}
+
+void EngineController::setBridgePort(quint16 port)
+{
+    bridge_port_ = port;
+}
+
+void EngineController::setWorkers(int count)
+{
+    workers_ = qMax(0, count);
+}
+
+void EngineController::setExecutable(const QString& path)
+{
+    executable_ = path.trimmed();
+}
+
+QString EngineController::resolveExecutable() const
+{
+    if (!executable_.isEmpty()) {
+        const QFileInfo info(QDir(working_directory_).filePath(executable_));
+        return isExecutable(info) ? info.absoluteFilePath() : QString();
+    }
+
+    // Honour CARGO_TARGET_DIR like cargo does, then prefer whichever profile was built last
+    // so a fresh debug build is not shadowed by a stale release one.
+    QString targetDir = QProcessEnvironment::systemEnvironment().value(QStringLiteral("CARGO_TARGET_DIR"));
+    if (targetDir.isEmpty()) {
+        targetDir = QStringLiteral("target");
+    }
+    const QDir target(QDir(working_directory_).filePath(targetDir));
+    QFileInfo newest;
+    for (const QString& profile : {QStringLiteral("release"), QStringLiteral("debug")}) {
+        const QFileInfo candidate(target.filePath(profile + QLatin1Char('/') + executableName()));
+        if (isExecutable(candidate) && (!newest.exists() || candidate.lastModified() > newest.lastModified())) {
+            newest = candidate;
+        }
+    }
+    return newest.exists() ? newest.absoluteFilePath() : QString();
+}
+
+void EngineController::start()
+{
+    if (state_ != State::Stopped) {
+        emit message(tr("Engine is already %1.").arg(state_ == State::Stopping ? tr("stopping") : tr("running")),
+                     LogSink::Severity::Warning);
+        return;
+    }
+
+    const QStringList serveArgs = {QStringLiteral("--serve"), QStringLiteral("--workers"), QString::number(workers_),
+                                   QStringLiteral("--bind"), QStringLiteral("127.0.0.1:%1").arg(bridge_port_)};
+    const QString binary = resolveExecutable();
+    process_.setWorkingDirectory(working_directory_);
+    setState(State::Starting);
+    start_clock_.start();
+    if (!binary.isEmpty()) {
+        launch_description_ = QDir(working_directory_).relativeFilePath(binary);
+        emit message(tr("Launching %1").arg(launch_description_), LogSink::Severity::Info);
+        process_.start(binary, serveArgs);
+        return;
+    }
+
+    if (!executable_.isEmpty()) {
+        emit message(tr("Engine binary %1 is not executable; falling back to cargo run.").arg(executable_),
+                     LogSink::Severity::Warning);
+    }
+    launch_description_ = QStringLiteral("cargo run");
+    emit message(tr("No prebuilt simulator found; launching via cargo run (first start may compile)."),
+                 LogSink::Severity::Info);
+    process_.start(QStringLiteral("cargo"), QStringList{QStringLiteral("run"), QStringLiteral("--bin"),
+                                                        QStringLiteral("simulator"), QStringLiteral("--")} +
+                                                serveArgs);
+}
+
+void EngineController::stop()
+{
+    if (state_ == State::Stopped || state_ == State::Stopping) {
+        return;
+    }
+    probe_timer_.stop();
+    setState(State::Stopping);
+    process_.terminate();
+    kill_timer_.start();
+}
+
+void EngineController::setState(State state)
+{
+    if (state_ == state) {
+        return;
+    }
+    state_ = state;
+    emit stateChanged(state);
+}
+
+void EngineController::probeBridge()
+{
+    // One probe in flight at a time; a refused connection just waits for the next tick.
+    if (state_ != State::Starting || probe_socket_) {
+        return;
+    }
+    auto* socket = new QTcpSocket(this);
+    probe_socket_ = socket;
+    connect(socket, &QTcpSocket::connected, this, [this, socket]() {
+        socket->abort();
+        socket->deleteLater();
+        if (state_ != State::Starting) {
+            return;
+        }
+        probe_timer_.stop();
+        setState(State::Running);
+        emit message(tr("Bridge ready on port %1 after %2 ms (%3).")
+                         .arg(bridge_port_)
+                         .arg(start_clock_.elapsed())
+                         .arg(launch_description_),
+                     LogSink::Severity::Info);
+    });
+    connect(socket, &QTcpSocket::errorOccurred, socket, &QObject::deleteLater);
+    socket->connectToHost(QHostAddress::LocalHost, bridge_port_);
+}
+
+void EngineController::onProcessError(QProcess::ProcessError error)
+{
+    if (error == QProcess::FailedToStart) {
+        // finished() is never emitted for a process that did not start.
+        probe_timer_.stop();
+        setState(State::Stopped);
+        emit message(tr("Failed to start simulator engine: %1").arg(process_.errorString()),
+                     LogSink::Severity::Error);
+        return;
+    }
+    if (state_ != State::Stopping) {
+        emit message(tr("Simulator engine reported an error: %1").arg(process_.errorString()),
+                     LogSink::Severity::Error);
+    }
+}
+
+void EngineController::onProcessFinished(int exitCode, QProcess::ExitStatus status)
+{
+    probe_timer_.stop();
+    kill_timer_.stop();
+    const bool expected = state_ == State::Stopping;
+    setState(State::Stopped);
+    if (expected) {
+        emit message(tr("Simulator server stopped."), LogSink::Severity::Info);
+    } else if (status == QProcess::CrashExit || exitCode != 0) {
+        emit message(tr("Simulator exited unexpectedly (code %1).").arg(exitCode), LogSink::Severity::Error);
+    } else {
+        emit message(tr("Simulator exited."), LogSink::Severity::Info);
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "LogSink.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointer>
+#include <QProcess>
+#include <QTimer>
+
+class QTcpSocket;
+
+// Owns the simulator engine process. Start and stop never block the GUI thread: the
+// lifecycle advances on QProcess signals, and the engine only counts as Running once a
+// probe connection to the bridge port succeeds.
+//
+// A prebuilt `simulator` binary is launched directly when one can be found, so a start
+// does not pay for Cargo's dependency resolution; `cargo run` is only the fallback.
+class EngineController : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class State
+    {
+        Stopped,
+        Starting,
+        Running,
+        Stopping
+    };
+    Q_ENUM(State)
+
+    explicit EngineController(QObject* parent = nullptr);
+    ~EngineController() override;
+
+    State state() const { return state_; }
+    void setWorkingDirectory(const QString& path);
+    // Port the next start binds the bridge to (--bind 127.0.0.1:<port>) and probes.
+    void setBridgePort(quint16 port);
+    // Bridge processing threads passed as --workers on the next start; 0 is one per core.
+    void setWorkers(int count);
+    // Explicit engine binary; empty means search the workspace target directories.
+    void setExecutable(const QString& path);
+    // Binary start() would launch, or empty when it would fall back to cargo.
+    QString resolveExecutable() const;
+
+    void start();
+    void stop();
+
+signals:
+    void stateChanged(EngineController::State state);
+    void outputReceived(const QByteArray& output);
+    void message(const QString& text, LogSink::Severity severity);
+
+private:
+    void setState(State state);
+    void probeBridge();
+    void onProcessError(QProcess::ProcessError error);
+    void onProcessFinished(int exitCode, QProcess::ExitStatus status);
+
+    QProcess process_;
+    QTimer probe_timer_;
+    QTimer kill_timer_;
+    QPointer<QTcpSocket> probe_socket_;
+    QElapsedTimer start_clock_;
+    QString working_directory_;
+    QString executable_;
+    QString launch_description_;
+    quint16 bridge_port_ = 9000;
+    int workers_ = 0;
+    State state_ = State::Stopped;
+};
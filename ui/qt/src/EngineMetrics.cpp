@@ -0,0 +1,130 @@
+#include "EngineMetrics.h"
+
+#include "EndpointPool.h"
+
+#include <QJsonDocument>
+#include <QNetworkReply>
+
+namespace
+{
+const char* const kStageKeys[] = {"range", "doppler", "clutter", "encode"};
+
+quint64 counter(const QJsonObject& object, const char* key)
+{
+    return static_cast<quint64>(object.value(QLatin1String(key)).toDouble());
+}
+
+// Counters only grow, except across an engine restart; treat a reset as a fresh start.
+quint64 delta(quint64 now, quint64 before)
+{
+    return now >= before ? now - before : now;
+}
+} // namespace
+
+EngineMetrics::EngineMetrics(EndpointPool* network, const QUrl& baseUrl, QObject* parent)
+    : QObject(parent)
+    , network_(network)
+    , url_(baseUrl)
+{
+    QString path = url_.path();
+    if (path.endsWith(QLatin1Char('/'))) {
+        path.chop(1);
+    }
+    url_.setPath(path + QStringLiteral("/metrics"));
+    connect(&timer_, &QTimer::timeout, this, &EngineMetrics::poll);
+}
+
+QString EngineMetrics::stageName(Stage stage)
+{
+    switch (stage) {
+    case Range:
+        return tr("Range");
+    case Doppler:
+        return tr("Doppler FFT");
+    case Clutter:
+        return tr("Clutter CFAR");
+    case Encode:
+        return tr("Bridge encode");
+    case StageCount:
+        break;
+    }
+    return QString();
+}
+
+void EngineMetrics::start(int intervalMs)
+{
+    timer_.start(intervalMs);
+    poll();
+}
+
+void EngineMetrics::stop()
+{
+    timer_.stop();
+    if (reply_) {
+        reply_->abort();
+    }
+}
+
+void EngineMetrics::poll()
+{
+    // A slow engine must not collect a queue of metric requests.
+    if (reply_) {
+        return;
+    }
+    QNetworkReply* reply = network_->get(network_->request(url_, timer_.interval()));
+    reply_ = reply;
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() { onReply(reply); });
+}
+
+void EngineMetrics::onReply(QNetworkReply* reply)
+{
+    reply->deleteLater();
+    const bool ok = reply->error() == QNetworkReply::NoError;
+    const QJsonObject current = ok ? QJsonDocument::fromJson(reply->readAll()).object() : QJsonObject();
+    if (current.isEmpty()) {
+        if (available_) {
+            available_ = false;
+            emit availabilityChanged(false);
+        }
+        previous_ = QJsonObject();
+        return;
+    }
+    if (!available_) {
+        available_ = true;
+        emit availabilityChanged(true);
+    }
+
+    const qint64 elapsed_ms = interval_clock_.isValid() ? interval_clock_.restart() : 0;
+    if (!interval_clock_.isValid()) {
+        interval_clock_.start();
+    }
+    if (previous_.isEmpty() || elapsed_ms <= 0) {
+        previous_ = current;
+        return;
+    }
+
+    Sample sample;
+    const QJsonObject stages = current.value(QStringLiteral("stages")).toObject();
+    const QJsonObject before = previous_.value(QStringLiteral("stages")).toObject();
+    for (int i = 0; i < StageCount; ++i) {
+        const QJsonObject now = stages.value(QLatin1String(kStageKeys[i])).toObject();
+        const QJsonObject then = before.value(QLatin1String(kStageKeys[i])).toObject();
+        const quint64 calls = delta(counter(now, "count"), counter(then, "count"));
+        const quint64 total_us = delta(counter(now, "total_us"), counter(then, "total_us"));
+        sample.stage_ms[i] = calls > 0 ? total_us / 1000.0 / calls : 0.0;
+    }
+    sample.frames_per_s = delta(counter(current, "processed"), counter(previous_, "processed")) * 1000.0 / elapsed_ms;
+    sample.errors = delta(counter(current, "errors"), counter(previous_, "errors"));
+    const QJsonObject pool = current.value(QStringLiteral("buffer_pool")).toObject();
+    const QJsonObject poolBefore = previous_.value(QStringLiteral("buffer_pool")).toObject();
+    sample.pool_checkouts = delta(counter(pool, "checkouts"), counter(poolBefore, "checkouts"));
+    sample.pool_exhausted = delta(counter(pool, "exhausted"), counter(poolBefore, "exhausted"));
+    sample.in_flight = current.value(QStringLiteral("in_flight")).toInt();
+    sample.peak_in_flight = current.value(QStringLiteral("peak_in_flight")).toInt();
+    sample.stream_subscribers = current.value(QStringLiteral("stream_subscribers")).toInt();
+    const QJsonObject queue = current.value(QStringLiteral("queue")).toObject();
+    sample.queue_depth = queue.value(QStringLiteral("queue_depth")).toInt();
+    sample.workers = queue.value(QStringLiteral("workers")).toInt();
+    previous_ = current;
+    emit sampleReady(sample);
+}
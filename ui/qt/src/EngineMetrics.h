@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QUrl>
+
+#include <array>
+
+class EndpointPool;
+class QNetworkReply;
+
+// Polls a bridge's GET /metrics and turns its cumulative counters into per-interval
+// samples: mean time per call of each pipeline stage, frames processed per second and
+// buffer-pool activity since the previous poll.
+class EngineMetrics : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Order of the bridge's `stages` keys that the chart plots.
+    enum Stage
+    {
+        Range,
+        Doppler,
+        Clutter,
+        Encode,
+        StageCount
+    };
+
+    struct Sample
+    {
+        // Mean milliseconds per call during the interval; 0 when the stage did not run.
+        std::array<double, StageCount> stage_ms{};
+        double frames_per_s = 0.0;
+        quint64 pool_checkouts = 0;
+        quint64 pool_exhausted = 0;
+        quint64 errors = 0;
+        int in_flight = 0;
+        int peak_in_flight = 0;
+        int stream_subscribers = 0;
+        // Bridge worker pool: jobs waiting for a thread, and the thread count.
+        int queue_depth = 0;
+        int workers = 0;
+    };
+
+    EngineMetrics(EndpointPool* network, const QUrl& baseUrl, QObject* parent = nullptr);
+
+    static QString stageName(Stage stage);
+
+    void start(int intervalMs = 1000);
+    void stop();
+
+signals:
+    void sampleReady(const EngineMetrics::Sample& sample);
+    // True once /metrics answers, false when a poll fails.
+    void availabilityChanged(bool available);
+
+private:
+    void poll();
+    void onReply(QNetworkReply* reply);
+
+    EndpointPool* network_;
+    QUrl url_;
+    QTimer timer_;
+    QPointer<QNetworkReply> reply_;
+    QElapsedTimer interval_clock_;
+    QJsonObject previous_;
+    bool available_ = false;
+};
@@ -0,0 +1,105 @@
+#include "EngineMetricsView.h"
+
+#include "RenderScheduler.h"
+
+#include <QFont>
+#include <QLinearGradient>
+#include <QPainter>
+#include <QPolygonF>
+#include <algorithm>
+
+namespace
+{
+// Stage colours follow the waterfall palette.
+const QColor kStageColours[EngineMetrics::StageCount] = {QColor(0, 90, 200), QColor(0, 190, 255),
+                                                         QColor(255, 220, 0), QColor(255, 255, 255)};
+constexpr int kLegendHeight = 22;
+} // namespace
+
+EngineMetricsView::EngineMetricsView(int historySamples, QWidget* parent)
+    : QWidget(parent)
+    , history_(qMax(2, historySamples))
+    , samples_(history_)
+{
+    setMinimumHeight(120);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+void EngineMetricsView::addSample(const EngineMetrics::Sample& sample)
+{
+    samples_[head_] = sample;
+    head_ = (head_ + 1) % history_;
+    filled_ = qMin(filled_ + 1, history_);
+    exhausted_total_ += sample.pool_exhausted;
+    RenderScheduler::instance().requestUpdate(this);
+}
+
+void EngineMetricsView::setAvailable(bool available)
+{
+    available_ = available;
+    RenderScheduler::instance().requestUpdate(this);
+}
+
+void EngineMetricsView::paintEvent(QPaintEvent*)
+{
+    QPainter painter(this);
+    QLinearGradient gradient(rect().topLeft(), rect().bottomRight());
+    gradient.setColorAt(0.0, QColor(22, 22, 22));
+    gradient.setColorAt(1.0, QColor(44, 44, 44));
+    painter.fillRect(rect(), gradient);
+    if (filled_ == 0) {
+        painter.setPen(Qt::gray);
+        painter.drawText(rect(), Qt::AlignCenter,
+                         available_ ? tr("Collecting engine metrics...") : tr("Engine metrics unavailable"));
+        return;
+    }
+
+    // Oldest sample first, so index i is always x = i.
+    const int oldest = (head_ - filled_ + history_) % history_;
+    auto sampleAt = [this, oldest](int i) -> const EngineMetrics::Sample& {
+        return samples_[(oldest + i) % history_];
+    };
+    double peak_ms = 0.0;
+    for (int i = 0; i < filled_; ++i) {
+        const auto& stages = sampleAt(i).stage_ms;
+        peak_ms = std::max(peak_ms, *std::max_element(stages.cbegin(), stages.cend()));
+    }
+    const double scale_ms = peak_ms > 0.0 ? peak_ms * 1.1 : 1.0;
+
+    const QRectF plot = QRectF(rect()).adjusted(8, 8 + kLegendHeight, -8, -8);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    for (int stage = 0; stage < EngineMetrics::StageCount; ++stage) {
+        QPolygonF trace;
+        trace.reserve(filled_);
+        for (int i = 0; i < filled_; ++i) {
+            const qreal x = plot.left() + plot.width() * i / (history_ - 1);
+            trace.append({x, plot.bottom() - plot.height() * sampleAt(i).stage_ms[stage] / scale_ms});
+        }
+        painter.setPen(QPen(kStageColours[stage], 1.5));
+        painter.drawPolyline(trace);
+    }
+
+    // Legend: each stage's newest mean, then throughput and pool pressure.
+    const EngineMetrics::Sample& latest = sampleAt(filled_ - 1);
+    painter.setFont(QFont(font().family(), 9));
+    qreal x = 10;
+    for (int stage = 0; stage < EngineMetrics::StageCount; ++stage) {
+        const QString label = tr("%1 %2 ms")
+                                  .arg(EngineMetrics::stageName(static_cast<EngineMetrics::Stage>(stage)))
+                                  .arg(latest.stage_ms[stage], 0, 'f', 2);
+        painter.setPen(kStageColours[stage]);
+        painter.drawText(QPointF(x, 8 + kLegendHeight / 2 + 4), label);
+        x += painter.fontMetrics().horizontalAdvance(label) + 16;
+    }
+    painter.setPen(Qt::white);
+    painter.setFont(QFont(font().family(), 10, QFont::Bold));
+    painter.drawText(rect().adjusted(12, 6, -12, -6), Qt::AlignTop | Qt::AlignRight,
+                     tr("%1 frames/s | in flight %2/%3 workers (peak %4), %5 queued | pool exhausted %6 | scale %7 ms")
+                         .arg(latest.frames_per_s, 0, 'f', 1)
+                         .arg(latest.in_flight)
+                         .arg(latest.workers)
+                         .arg(latest.peak_in_flight)
+                         .arg(latest.queue_depth)
+                         .arg(exhausted_total_)
+                         .arg(scale_ms, 0, 'f', 2));
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "EngineMetrics.h"
+
+#include <QVector>
+#include <QWidget>
+
+// Rolling chart of EngineMetrics samples in the StatusGraph style: one trace per
+// pipeline stage (mean ms per call), auto-scaled, with the newest values, throughput
+// and buffer-pool exhaustions in the legend. Shows where a frame's time goes: FFT,
+// CFAR or the bridge's serialisation.
+class EngineMetricsView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit EngineMetricsView(int historySamples = 120, QWidget* parent = nullptr);
+
+public slots:
+    void addSample(const EngineMetrics::Sample& sample);
+    void setAvailable(bool available);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    int history_;
+    // Ring of the newest `history_` samples; head_ is the slot the next one is written to.
+    QVector<EngineMetrics::Sample> samples_;
+    int head_ = 0;
+    int filled_ = 0;
+    quint64 exhausted_total_ = 0;
+    bool available_ = false;
+};
@@ -0,0 +1,235 @@
+#include "FrameDecoder.h"
+
+#include "Diagnostics.h"
+#include "ProfileKernels.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+// Frames only arrive out of order when a poll reply races the stream, a few sequences
+// apart. A sequence further back than this comes from a restarted bridge, even one too
+// old to send run ids, whose client missed the new run's first frames.
+constexpr quint64 kMaxStaleGap = 64;
+
+void appendRecords(const QJsonArray& array, QVector<FrameFormat::DetectionRecord>& out)
+{
+    out.reserve(out.size() + array.size());
+    for (const auto& value : array) {
+        const auto record = value.toObject();
+        out.append({record.value("timestamp").toDouble(),
+                    static_cast<float>(record.value("range").toDouble()),
+                    static_cast<float>(record.value("doppler").toDouble()),
+                    static_cast<float>(record.value("snr").toDouble()),
+                    static_cast<float>(record.value("bearing_deg").toDouble()),
+                    static_cast<float>(record.value("elevation_deg").toDouble()),
+                    0});
+    }
+}
+
+QStringList toStringList(const QJsonArray& array)
+{
+    QStringList out;
+    out.reserve(array.size());
+    for (const auto& value : array) {
+        out.append(value.toString());
+    }
+    return out;
+}
+} // namespace
+
+FrameDecoder::FrameDecoder(int frameBuffers, QObject* parent)
+    : QObject(parent)
+    , pool_(frameBuffers)
+{
+}
+
+void FrameDecoder::decodePayload(const QByteArray& body, bool binary, qint64 origin_us, qint64 received_us)
+{
+    FrameSnapshot frame;
+    const int slot = pool_.checkout(frame);
+    const bool ok = binary ? decodeBinary(body.constData(), body.size(), frame) : decodeJson(body, frame);
+    pool_.release(slot, frame);
+    if (ok) {
+        publish(std::move(frame), origin_us, received_us);
+    } else {
+        emit resyncRequired();
+    }
+}
+
+void FrameDecoder::appendStreamData(const QByteArray& chunk, bool binary, qint64 received_us)
+{
+    stream_buffer_.append(chunk);
+    qsizetype begin = 0;
+    if (binary) {
+        // Binary frames carry their own length; keep any partial frame for the next chunk.
+        while (begin < stream_buffer_.size()) {
+            const char* data = stream_buffer_.constData() + begin;
+            const qsizetype available = stream_buffer_.size() - begin;
+            const qsizetype frameBytes = FrameFormat::peekFrameSize(data, available);
+            if (frameBytes < 0) {
+                stream_buffer_.clear();
+                emit streamCorrupted();
+                return;
+            }
+            if (frameBytes == 0 || frameBytes > available) {
+                break;
+            }
+            FrameSnapshot frame;
+            const int slot = pool_.checkout(frame);
+            const bool ok = decodeBinary(data, frameBytes, frame);
+            pool_.release(slot, frame);
+            if (ok) {
+                publish(std::move(frame), received_us, received_us);
+            }
+            begin += frameBytes;
+        }
+    } else {
+        // The bridge writes one JSON document per line; keep any partial line for the next chunk.
+        for (qsizetype end = stream_buffer_.indexOf('\n'); end >= 0; end = stream_buffer_.indexOf('\n', begin)) {
+            if (end > begin) {
+                FrameSnapshot frame;
+                const int slot = pool_.checkout(frame);
+                const bool ok = decodeJson(stream_buffer_.mid(begin, end - begin), frame);
+                pool_.release(slot, frame);
+                if (ok) {
+                    publish(std::move(frame), received_us, received_us);
+                }
+            }
+            begin = end + 1;
+        }
+    }
+    stream_buffer_.remove(0, begin);
+}
+
+void FrameDecoder::resetStream()
+{
+    stream_buffer_.clear();
+}
+
+void FrameDecoder::reset()
+{
+    stream_buffer_.clear();
+    retained_ = FrameSnapshot();
+}
+
+bool FrameDecoder::decodeJson(const QByteArray& body, FrameSnapshot& frame) const
+{
+    const auto doc = QJsonDocument::fromJson(body);
+    if (!doc.isObject()) {
+        return false;
+    }
+
+    const auto obj = doc.object();
+    frame.sequence = static_cast<quint64>(obj.value("sequence").toDouble(0));
+    frame.run_id = static_cast<quint64>(obj.value("run_id").toDouble(0));
+    frame.request_id = obj.value("request_id").toString();
+    frame.detection_count = obj.value("detection_count").toInt(0);
+    if (obj.value("delta").toBool(false)) {
+        return applyDelta(obj, frame);
+    }
+
+    const auto powerArray = obj.value("power_profile").toArray();
+    frame.profile.reserve(powerArray.size());
+    for (const auto& value : powerArray) {
+        frame.profile.append(static_cast<float>(value.toDouble()));
+    }
+    appendRecords(obj.value("detection_records").toArray(), frame.records);
+    frame.notes = toStringList(obj.value("detection_notes").toArray());
+    frame.scenario_metadata = obj.value("scenario_metadata").toObject();
+    return true;
+}
+
+bool FrameDecoder::applyDelta(const QJsonObject& obj, FrameSnapshot& frame) const
+{
+    // A delta is only meaningful on top of the exact frame the bridge diffed against.
+    if (static_cast<quint64>(obj.value("base_sequence").toDouble(-1)) != retained_.sequence ||
+        frame.run_id != retained_.run_id) {
+        return false;
+    }
+
+    if (obj.contains("power_profile")) {
+        const auto powerArray = obj.value("power_profile").toArray();
+        frame.profile.reserve(powerArray.size());
+        for (const auto& value : powerArray) {
+            frame.profile.append(static_cast<float>(value.toDouble()));
+        }
+    } else {
+        // Copied into the pooled buffer rather than shared: a buffer referenced by two
+        // slots would never be free again.
+        frame.profile.append(retained_.profile);
+        const auto changes = obj.value("profile_changes").toArray();
+        if (!changes.isEmpty()) {
+            float* samples = frame.profile.data();
+            for (const auto& change : changes) {
+                const auto pair = change.toArray();
+                const int index = pair.at(0).toInt(-1);
+                if (index >= 0 && index < frame.profile.size()) {
+                    samples[index] = static_cast<float>(pair.at(1).toDouble());
+                }
+            }
+        }
+    }
+
+    if (obj.contains("records_kept")) {
+        const int kept = qBound(0, obj.value("records_kept").toInt(0), static_cast<int>(retained_.records.size()));
+        frame.records.resize(kept);
+        std::copy_n(retained_.records.cbegin(), kept, frame.records.begin());
+        appendRecords(obj.value("detection_records").toArray(), frame.records);
+    } else {
+        frame.records.append(retained_.records);
+    }
+    frame.notes = obj.contains("detection_notes") ? toStringList(obj.value("detection_notes").toArray())
+                                                  : retained_.notes;
+    frame.scenario_metadata = obj.contains("scenario_metadata") ? obj.value("scenario_metadata").toObject()
+                                                                : retained_.scenario_metadata;
+    return true;
+}
+
+bool FrameDecoder::decodeBinary(const char* data, qsizetype size, FrameSnapshot& frame) const
+{
+    FrameFormat::FrameView view;
+    if (!FrameFormat::decodeFrame(data, size, view)) {
+        return false;
+    }
+    FrameFormat::copyProfile(view, frame.profile);
+    FrameFormat::copyRecords(view, frame.records);
+    frame.sequence = view.header.sequence;
+    frame.run_id = view.run_id;
+    frame.request_id = QString::fromUtf8(view.request_id, view.request_id_len);
+    frame.detection_count = static_cast<int>(view.header.detection_count);
+    return true;
+}
+
+void FrameDecoder::publish(FrameSnapshot&& frame, qint64 origin_us, qint64 received_us)
+{
+    const quint64 last = retained_.sequence;
+    // Sequences start over with each bridge run. Bridges that send no run id are only
+    // recognised by a sequence back at 0/1 or far behind the last one.
+    const bool restarted = frame.run_id != retained_.run_id ||
+                           (frame.sequence < last && (frame.sequence <= 1 || last - frame.sequence > kMaxStaleGap));
+    // Each stream opens with the current frame, which a poll may already have delivered.
+    if (frame.sequence == last && !restarted) {
+        return;
+    }
+    if (frame.sequence < last && !restarted) {
+        emit framesDropped(1);
+        return;
+    }
+    if (!restarted && last != 0 && frame.sequence > last + 1) {
+        emit framesDropped(frame.sequence - last - 1);
+    }
+    if (!frame.profile.isEmpty()) {
+        frame.peak = ProfileKernels::maxValue(frame.profile.constData(), frame.profile.size());
+    }
+    frame.origin_us = origin_us;
+    frame.received_us = received_us;
+    frame.decoded_us = Diagnostics::nowUs();
+    Diagnostics::instance().record(Diagnostics::Stage::Decode, frame.decoded_us - received_us);
+    retained_ = frame;
+    emit frameDecoded(frame);
+}
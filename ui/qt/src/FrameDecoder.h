@@ -0,0 +1,45 @@
+#pragma once
+
+#include "FramePool.h"
+#include "FrameSnapshot.h"
+
+#include <QByteArray>
+#include <QObject>
+
+// Turns /payload bodies and /stream chunks into FrameSnapshots. Lives on a worker
+// thread owned by DataProvider; all entry points are invoked through queued calls.
+// Profiles and records are decoded into buffers checked out of a FramePool.
+class FrameDecoder : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FrameDecoder(int frameBuffers = FramePool::kDefaultCapacity, QObject* parent = nullptr);
+
+    // `origin_us`/`received_us` are Diagnostics::nowUs() stamps carried into the snapshot.
+    void decodePayload(const QByteArray& body, bool binary, qint64 origin_us, qint64 received_us);
+    void appendStreamData(const QByteArray& chunk, bool binary, qint64 received_us);
+    void resetStream();
+    // Forgets the retained frame too, so the next frame is accepted whatever its sequence.
+    void reset();
+
+signals:
+    void frameDecoded(const FrameSnapshot& frame);
+    void framesDropped(quint64 count);
+    void streamCorrupted();
+    // A /payload body could not be decoded, typically a delta against a frame this decoder
+    // no longer holds (a restarted bridge, or a reset); the next poll must ask for the full
+    // model.
+    void resyncRequired();
+
+private:
+    bool decodeJson(const QByteArray& body, FrameSnapshot& frame) const;
+    bool applyDelta(const QJsonObject& obj, FrameSnapshot& frame) const;
+    bool decodeBinary(const char* data, qsizetype size, FrameSnapshot& frame) const;
+    void publish(FrameSnapshot&& frame, qint64 origin_us, qint64 received_us);
+
+    FramePool pool_;
+    QByteArray stream_buffer_;
+    // Last published frame; `/payload?since=` deltas are merged on top of it.
+    FrameSnapshot retained_;
+};
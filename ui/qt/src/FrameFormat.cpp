@@ -0,0 +1,97 @@
+#include "FrameFormat.h"
+
+#include <QSysInfo>
+#include <cstring>
+
+namespace FrameFormat
+{
+namespace
+{
+static_assert(QSysInfo::ByteOrder == QSysInfo::LittleEndian,
+              "binary frames are decoded in place and assume a little-endian host");
+
+qsizetype paddedProfileBytes(quint32 len)
+{
+    return (static_cast<qsizetype>(len) * 4 + 7) & ~qsizetype(7);
+}
+
+qsizetype frameSize(const Header& header)
+{
+    return header.header_bytes + paddedProfileBytes(header.profile_len)
+           + static_cast<qsizetype>(header.record_count) * header.record_stride;
+}
+} // namespace
+
+qsizetype peekFrameSize(const char* data, qsizetype size)
+{
+    if (size < static_cast<qsizetype>(sizeof(Header))) {
+        return 0;
+    }
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+    if (header.magic != kMagic || header.version != kVersion
+        || header.header_bytes < sizeof(Header)
+        || header.record_stride < sizeof(DetectionRecord)) {
+        return -1;
+    }
+    return frameSize(header);
+}
+
+bool decodeFrame(const char* data, qsizetype size, FrameView& view)
+{
+    const qsizetype expected = peekFrameSize(data, size);
+    if (expected <= 0 || size < expected) {
+        return false;
+    }
+    std::memcpy(&view.header, data, sizeof(Header));
+    view.run_id = 0;
+    if (view.header.header_bytes >= kRunIdOffset + static_cast<qsizetype>(sizeof(view.run_id))) {
+        std::memcpy(&view.run_id, data + kRunIdOffset, sizeof(view.run_id));
+    }
+    view.request_id = nullptr;
+    view.request_id_len = 0;
+    if (view.header.header_bytes >= kRequestIdOffset) {
+        quint16 length;
+        std::memcpy(&length, data + kRequestIdLengthOffset, sizeof(length));
+        if (kRequestIdOffset + length <= view.header.header_bytes) {
+            view.request_id = data + kRequestIdOffset;
+            view.request_id_len = length;
+        }
+    }
+    view.profile = data + view.header.header_bytes;
+    view.records = view.profile + paddedProfileBytes(view.header.profile_len);
+    view.frame_bytes = expected;
+    return true;
+}
+
+void copyProfile(const FrameView& view, QVector<float>& out)
+{
+    out.resize(view.header.profile_len);
+    if (!out.isEmpty()) {
+        std::memcpy(out.data(), view.profile, out.size() * sizeof(float));
+    }
+}
+
+void copyRecords(const FrameView& view, QVector<DetectionRecord>& out)
+{
+    out.resize(view.header.record_count);
+    if (out.isEmpty()) {
+        return;
+    }
+    if (view.header.record_stride == sizeof(DetectionRecord)) {
+        std::memcpy(out.data(), view.records, out.size() * sizeof(DetectionRecord));
+        return;
+    }
+    for (quint32 i = 0; i < view.header.record_count; ++i) {
+        out[i] = recordAt(view, i);
+    }
+}
+
+DetectionRecord recordAt(const FrameView& view, quint32 index)
+{
+    DetectionRecord record;
+    std::memcpy(&record, view.records + static_cast<qsizetype>(index) * view.header.record_stride,
+                sizeof(DetectionRecord));
+    return record;
+}
+} // namespace FrameFormat
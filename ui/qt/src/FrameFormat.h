@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QByteArray>
+#include <QVector>
+#include <QtGlobal>
+
+// Binary frame layout served by the bridge for `Accept: application/x-gmti-frame`.
+// Mirrors simulator/src/gui_bridge/frame.rs; all fields are little-endian.
+namespace FrameFormat
+{
+inline constexpr char kContentType[] = "application/x-gmti-frame";
+inline constexpr quint32 kMagic = 0x46544D47; // "GMTF"
+inline constexpr quint16 kVersion = 1;
+
+struct Header
+{
+    quint32 magic;
+    quint16 version;
+    quint16 header_bytes;
+    quint64 sequence;
+    quint32 detection_count;
+    quint32 profile_len;
+    quint32 record_count;
+    quint16 record_stride;
+    quint16 reserved;
+};
+static_assert(sizeof(Header) == 32, "frame header must match the wire layout");
+
+// Optional fields appended after Header and covered by header_bytes; older bridges omit them.
+inline constexpr qsizetype kRunIdOffset = sizeof(Header);
+// quint16 byte count of the UTF-8 request id stored from kRequestIdOffset.
+inline constexpr qsizetype kRequestIdLengthOffset = kRunIdOffset + sizeof(quint64);
+inline constexpr qsizetype kRequestIdOffset = kRequestIdLengthOffset + 8;
+
+struct DetectionRecord
+{
+    double timestamp;
+    float range;
+    float doppler;
+    float snr;
+    float bearing_deg;
+    float elevation_deg;
+    quint32 reserved;
+};
+static_assert(sizeof(DetectionRecord) == 32, "detection record must match the wire layout");
+
+// Non-owning view into an encoded frame; valid while the source buffer is alive.
+struct FrameView
+{
+    Header header{};
+    // Bridge run that published the frame, 0 when the header predates run ids.
+    quint64 run_id = 0;
+    // X-Request-Id of the submission that produced the frame; empty when untagged.
+    const char* request_id = nullptr;
+    quint16 request_id_len = 0;
+    const char* profile = nullptr;
+    const char* records = nullptr;
+    qsizetype frame_bytes = 0;
+};
+
+// Returns the full size of the frame starting at `data`, 0 if more bytes are needed
+// to know, or -1 if the bytes are not a frame this client understands.
+qsizetype peekFrameSize(const char* data, qsizetype size);
+
+// Validates and maps a complete frame without copying the sample or record arrays.
+bool decodeFrame(const char* data, qsizetype size, FrameView& view);
+
+// Copies the profile into `out` with a single allocation and memcpy.
+void copyProfile(const FrameView& view, QVector<float>& out);
+
+// Copies every record into `out`; a single memcpy when the stride matches this build.
+void copyRecords(const FrameView& view, QVector<DetectionRecord>& out);
+
+DetectionRecord recordAt(const FrameView& view, quint32 index);
+} // namespace FrameFormat
@@ -0,0 +1,65 @@
+#include "FramePool.h"
+
+#include "Diagnostics.h"
+
+#include <utility>
+
+namespace
+{
+// A vector that never allocated has nothing to share; otherwise it is free once the pool
+// holds the last reference.
+template <typename T>
+bool unshared(const QVector<T>& buffer)
+{
+    return buffer.capacity() == 0 || buffer.isDetached();
+}
+} // namespace
+
+FramePool::FramePool(int capacity)
+    : slots_(static_cast<size_t>(qMax(1, capacity)))
+{
+}
+
+bool FramePool::isFree(const Slot& slot)
+{
+    return !slot.checked_out && unshared(slot.profile) && unshared(slot.records);
+}
+
+int FramePool::checkout(FrameSnapshot& frame)
+{
+    int free = -1;
+    // Slots referenced right now, counting the one this checkout needs.
+    int inUse = 1;
+    for (int i = 0; i < capacity(); ++i) {
+        if (!isFree(slots_[i])) {
+            ++inUse;
+        } else if (free < 0) {
+            free = i;
+        }
+    }
+    if (free < 0) {
+        Diagnostics::instance().addFrameBufferCheckout(inUse, capacity(), false, true);
+        return -1;
+    }
+
+    Slot& slot = slots_[free];
+    Diagnostics::instance().addFrameBufferCheckout(inUse, capacity(), slot.profile.capacity() > 0, false);
+    // A detached clear() keeps the allocation.
+    frame.profile = std::move(slot.profile);
+    frame.profile.clear();
+    frame.records = std::move(slot.records);
+    frame.records.clear();
+    slot.checked_out = true;
+    return free;
+}
+
+void FramePool::release(int slot, const FrameSnapshot& frame)
+{
+    if (slot < 0 || slot >= capacity()) {
+        return;
+    }
+    Slot& owner = slots_[slot];
+    owner.profile = frame.profile;
+    owner.records = frame.records;
+    owner.checked_out = false;
+}
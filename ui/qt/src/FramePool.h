@@ -0,0 +1,41 @@
+#pragma once
+
+#include "FrameSnapshot.h"
+
+#include <vector>
+
+// Fixed set of reusable profile and record buffers for one FrameDecoder, the client's
+// counterpart of the engine's BufferPool. A checkout lends a slot's vectors to the frame
+// being decoded; the widgets then hold them through FrameSnapshot's implicit sharing.
+// Once every copy is gone (each widget has moved on to a newer frame), the slot is the
+// only owner again and the next checkout refills the vectors in place, so steady-state
+// decoding does not allocate. Checkouts run on the decoder thread only; other threads
+// merely drop references, and the reference count is atomic.
+class FramePool
+{
+public:
+    static constexpr int kDefaultCapacity = 8;
+
+    explicit FramePool(int capacity = kDefaultCapacity);
+
+    // Moves a free slot's buffers into `frame`, emptied but with their capacity kept, and
+    // returns the slot. When every slot is still referenced, `frame` keeps its own
+    // buffers, the exhaustion is counted and -1 returned.
+    int checkout(FrameSnapshot& frame);
+    // Gives `slot` back its buffers, now shared with `frame`. Call once decoding is done,
+    // whether or not the frame is published.
+    void release(int slot, const FrameSnapshot& frame);
+    int capacity() const { return static_cast<int>(slots_.size()); }
+
+private:
+    struct Slot
+    {
+        QVector<float> profile;
+        QVector<FrameFormat::DetectionRecord> records;
+        bool checked_out = false;
+    };
+
+    static bool isFree(const Slot& slot);
+
+    std::vector<Slot> slots_;
+};
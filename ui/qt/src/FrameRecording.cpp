@@ -0,0 +1,104 @@
+#include "FrameRecording.h"
+
+#include <QDateTime>
+#include <cstring>
+
+namespace FrameRecording
+{
+static_assert(Q_BYTE_ORDER == Q_LITTLE_ENDIAN, "recordings are written in host order");
+
+bool Writer::open(const QString& path, QString* error)
+{
+    close();
+    file_.setFileName(path);
+    if (!file_.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        *error = file_.errorString();
+        return false;
+    }
+    const FileHeader header{kMagic, kVersion, sizeof(FileHeader), QDateTime::currentMSecsSinceEpoch()};
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    first_us_ = -1;
+    return true;
+}
+
+void Writer::append(const QByteArray& payload, quint32 flags, qint64 now_us)
+{
+    if (!file_.isOpen()) {
+        return;
+    }
+    if (first_us_ < 0) {
+        first_us_ = now_us;
+    }
+    const RecordHeader header{static_cast<quint32>(payload.size()), flags, now_us - first_us_};
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file_.write(payload);
+}
+
+void Writer::close()
+{
+    if (file_.isOpen()) {
+        file_.close();
+    }
+}
+
+bool Reader::open(const QString& path, QString* error)
+{
+    file_.setFileName(path);
+    if (!file_.open(QIODevice::ReadOnly)) {
+        *error = file_.errorString();
+        return false;
+    }
+    size_ = file_.size();
+    data_ = size_ > 0 ? file_.map(0, size_) : nullptr;
+    FileHeader header{};
+    if (!data_ || size_ < static_cast<qint64>(sizeof(header))) {
+        *error = QStringLiteral("not a recording (too short or cannot be mapped)");
+        return false;
+    }
+    std::memcpy(&header, data_, sizeof(header));
+    if (header.magic != kMagic || header.version != kVersion || header.header_bytes < sizeof(header) ||
+        header.header_bytes > size_) {
+        *error = QStringLiteral("not a version %1 recording").arg(kVersion);
+        return false;
+    }
+
+    // Count complete records up front so a truncated tail (crash mid-write) is simply ignored.
+    rewind();
+    qint64 offset = header.header_bytes;
+    record_count_ = 0;
+    while (offset + static_cast<qint64>(sizeof(RecordHeader)) <= size_) {
+        RecordHeader record{};
+        std::memcpy(&record, data_ + offset, sizeof(record));
+        const qint64 end = offset + static_cast<qint64>(sizeof(record)) + record.payload_bytes;
+        if (end > size_) {
+            break;
+        }
+        offset = end;
+        ++record_count_;
+    }
+    size_ = offset;
+    return true;
+}
+
+bool Reader::next(Record* record)
+{
+    if (offset_ + static_cast<qint64>(sizeof(RecordHeader)) > size_) {
+        return false;
+    }
+    RecordHeader header{};
+    std::memcpy(&header, data_ + offset_, sizeof(header));
+    offset_ += sizeof(header);
+    record->arrival_us = header.arrival_us;
+    record->flags = header.flags;
+    record->payload = QByteArray::fromRawData(reinterpret_cast<const char*>(data_ + offset_), header.payload_bytes);
+    offset_ += header.payload_bytes;
+    return true;
+}
+
+void Reader::rewind()
+{
+    FileHeader header{};
+    std::memcpy(&header, data_, sizeof(header));
+    offset_ = header.header_bytes;
+}
+} // namespace FrameRecording
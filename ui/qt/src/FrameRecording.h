@@ -0,0 +1,84 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QtGlobal>
+
+// Capture file for raw bridge replies, so a session can be replayed without a simulator.
+// Little-endian layout:
+//
+//   file header (16 bytes): magic "GMTR", version u16, header_bytes u16, started_ms i64
+//   per record (16 bytes):  payload_bytes u32, flags u32, arrival_us i64, then the payload
+//
+// `arrival_us` is relative to the first record. Payloads are stored exactly as received:
+// whole /payload bodies, or raw /stream chunks that still need framing. An empty
+// StreamReset record marks the start of each /stream response, so replay discards any
+// partial frame the previous response left behind, as the live decoder does.
+namespace FrameRecording
+{
+inline constexpr quint32 kMagic = 0x524D5447; // "GMTR"
+inline constexpr quint16 kVersion = 1;
+
+enum RecordFlag : quint32
+{
+    BinaryPayload = 1u << 0,
+    StreamChunk = 1u << 1,
+    StreamReset = 1u << 2,
+};
+
+struct FileHeader
+{
+    quint32 magic;
+    quint16 version;
+    quint16 header_bytes;
+    qint64 started_ms;
+};
+static_assert(sizeof(FileHeader) == 16, "recording header must match the file layout");
+
+struct RecordHeader
+{
+    quint32 payload_bytes;
+    quint32 flags;
+    qint64 arrival_us;
+};
+static_assert(sizeof(RecordHeader) == 16, "record header must match the file layout");
+
+struct Record
+{
+    qint64 arrival_us = 0;
+    quint32 flags = 0;
+    // Points into the mapped file; valid while the Reader is alive.
+    QByteArray payload;
+};
+
+class Writer
+{
+public:
+    bool open(const QString& path, QString* error);
+    bool isOpen() const { return file_.isOpen(); }
+    void append(const QByteArray& payload, quint32 flags, qint64 now_us);
+    void close();
+
+private:
+    QFile file_;
+    qint64 first_us_ = -1;
+};
+
+// Memory-maps a recording and walks it record by record without copying payloads.
+class Reader
+{
+public:
+    bool open(const QString& path, QString* error);
+    bool next(Record* record);
+    void rewind();
+    qint64 recordCount() const { return record_count_; }
+
+private:
+    QFile file_;
+    const uchar* data_ = nullptr;
+    qint64 size_ = 0;
+    qint64 offset_ = 0;
+    qint64 record_count_ = 0;
+};
+} // namespace FrameRecording
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "FrameFormat.h"
+
+#include <QJsonObject>
+#include <QMetaType>
+#include <QStringList>
+#include <QVector>
+
+// Decoded, ready-to-draw frame handed from the decoder thread to the widgets.
+// Copies are cheap: both arrays are implicitly shared and never modified after decoding.
+struct FrameSnapshot
+{
+    quint64 sequence = 0;
+    // Bridge run the sequence belongs to (0 from bridges that predate run ids); sequences
+    // start over when it changes.
+    quint64 run_id = 0;
+    // X-Request-Id of the /ingest or /ingest-config submission behind the frame; empty
+    // for untagged submissions and frames the engine published itself.
+    QString request_id;
+    int detection_count = 0;
+    float peak = 0.0f;
+    QVector<float> profile;
+    QVector<FrameFormat::DetectionRecord> records;
+    // Only carried by JSON frames; binary frames leave them empty.
+    QStringList notes;
+    QJsonObject scenario_metadata;
+    // Diagnostics::nowUs() stamps along the pipeline: poll sent (or stream chunk
+    // received), body/chunk received, snapshot built, dataReady emitted.
+    qint64 origin_us = 0;
+    qint64 received_us = 0;
+    qint64 decoded_us = 0;
+    qint64 dispatched_us = 0;
+};
+
+Q_DECLARE_METATYPE(FrameSnapshot)
@@ -0,0 +1,163 @@
+#include "GlStatusGraph.h"
+
+#include "Diagnostics.h"
+#include "RenderScheduler.h"
+
+#include <QFont>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QPainter>
+#include <numeric>
+
+namespace
+{
+const char* const kVertexShader = R"(
+attribute highp float a_index;
+attribute highp float a_value;
+uniform highp float u_last_index;
+uniform highp float u_scale;
+void main()
+{
+    highp float x = u_last_index > 0.0 ? a_index / u_last_index * 2.0 - 1.0 : 0.0;
+    highp float y = clamp(a_value * u_scale, 0.0, 1.0) * 2.0 - 1.0;
+    gl_Position = vec4(x, y, 0.0, 1.0);
+}
+)";
+
+const char* const kFragmentShader = R"(
+uniform lowp vec4 u_color;
+void main()
+{
+    gl_FragColor = u_color;
+}
+)";
+} // namespace
+
+GlStatusGraph::GlStatusGraph(QWidget* parent)
+    : QOpenGLWidget(parent)
+    , index_buffer_(QOpenGLBuffer::VertexBuffer)
+    , value_buffer_(QOpenGLBuffer::VertexBuffer)
+{
+    setMinimumHeight(120);
+}
+
+GlStatusGraph::~GlStatusGraph()
+{
+    makeCurrent();
+    index_buffer_.destroy();
+    value_buffer_.destroy();
+    vao_.destroy();
+    doneCurrent();
+}
+
+bool GlStatusGraph::isSupported()
+{
+    QOffscreenSurface surface;
+    surface.create();
+    QOpenGLContext context;
+    if (!context.create() || !context.makeCurrent(&surface)) {
+        return false;
+    }
+    const auto* renderer = reinterpret_cast<const char*>(context.functions()->glGetString(GL_RENDERER));
+    const QByteArray name = renderer ? QByteArray(renderer).toLower() : QByteArray();
+    context.doneCurrent();
+    return !name.isEmpty() && !name.contains("llvmpipe") && !name.contains("softpipe")
+           && !name.contains("swiftshader") && !name.contains("software");
+}
+
+void GlStatusGraph::updateData(const FrameSnapshot& frame)
+{
+    profile_ = frame.profile;
+    detection_count_ = frame.detection_count;
+    max_value_ = frame.peak;
+    pending_origin_us_ = frame.origin_us;
+    pending_dispatch_us_ = frame.dispatched_us;
+    profile_dirty_ = true;
+    RenderScheduler::instance().requestUpdate(this);
+}
+
+void GlStatusGraph::initializeGL()
+{
+    initializeOpenGLFunctions();
+    program_.addShaderFromSourceCode(QOpenGLShader::Vertex, kVertexShader);
+    program_.addShaderFromSourceCode(QOpenGLShader::Fragment, kFragmentShader);
+    program_.bindAttributeLocation("a_index", 0);
+    program_.bindAttributeLocation("a_value", 1);
+    program_.link();
+
+    vao_.create();
+    index_buffer_.create();
+    index_buffer_.setUsagePattern(QOpenGLBuffer::StaticDraw);
+    value_buffer_.create();
+    value_buffer_.setUsagePattern(QOpenGLBuffer::StreamDraw);
+    profile_dirty_ = true;
+}
+
+void GlStatusGraph::uploadProfile()
+{
+    const int count = profile_.size();
+    QOpenGLVertexArrayObject::Binder binder(&vao_);
+
+    // The x coordinates only depend on the sample count, so they are uploaded once per size.
+    if (count > index_count_) {
+        QVector<float> indices(count);
+        std::iota(indices.begin(), indices.end(), 0.0f);
+        index_buffer_.bind();
+        index_buffer_.allocate(indices.constData(), count * static_cast<int>(sizeof(float)));
+        program_.enableAttributeArray(0);
+        program_.setAttributeBuffer(0, GL_FLOAT, 0, 1);
+        index_count_ = count;
+    }
+
+    value_buffer_.bind();
+    if (count > value_buffer_.size() / static_cast<int>(sizeof(float))) {
+        value_buffer_.allocate(profile_.constData(), count * static_cast<int>(sizeof(float)));
+    } else {
+        value_buffer_.write(0, profile_.constData(), count * static_cast<int>(sizeof(float)));
+    }
+    program_.enableAttributeArray(1);
+    program_.setAttributeBuffer(1, GL_FLOAT, 0, 1);
+    value_buffer_.release();
+
+    uploaded_count_ = count;
+    profile_dirty_ = false;
+}
+
+void GlStatusGraph::paintGL()
+{
+    glClearColor(22.0f / 255.0f, 22.0f / 255.0f, 22.0f / 255.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    if (profile_dirty_) {
+        uploadProfile();
+    }
+
+    if (uploaded_count_ > 0) {
+        program_.bind();
+        program_.setUniformValue("u_last_index", static_cast<GLfloat>(uploaded_count_ - 1));
+        program_.setUniformValue("u_scale", max_value_ > 0.0f ? 1.0f / max_value_ : 0.0f);
+        program_.setUniformValue("u_color", QColor(0, 190, 255));
+        QOpenGLVertexArrayObject::Binder binder(&vao_);
+        glDrawArrays(GL_LINE_STRIP, 0, uploaded_count_);
+        program_.release();
+    }
+
+    QPainter painter(this);
+    if (uploaded_count_ == 0) {
+        painter.setPen(Qt::gray);
+        painter.drawText(rect(), Qt::AlignCenter, tr("Awaiting data..."));
+    }
+    painter.setPen(Qt::white);
+    painter.setFont(QFont(font().family(), 10, QFont::Bold));
+    painter.drawText(rect().adjusted(12, 10, -12, -10), Qt::AlignTop | Qt::AlignRight,
+                     tr("Detections: %1").arg(detection_count_));
+    painter.end();
+
+    // Measured once the frame is submitted; the compositor swap happens after this.
+    if (pending_dispatch_us_ != 0) {
+        const qint64 now = Diagnostics::nowUs();
+        Diagnostics::instance().record(Diagnostics::Stage::Paint, now - pending_dispatch_us_);
+        Diagnostics::instance().record(Diagnostics::Stage::EndToEnd, now - pending_origin_us_);
+        pending_dispatch_us_ = 0;
+    }
+}
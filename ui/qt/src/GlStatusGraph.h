@@ -0,0 +1,48 @@
+#pragma once
+
+#include "FrameSnapshot.h"
+
+#include <QOpenGLBuffer>
+#include <QOpenGLFunctions>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLVertexArrayObject>
+#include <QOpenGLWidget>
+#include <QVector>
+
+// GPU-backed drop-in for StatusGraph: each profile is uploaded as a vertex buffer
+// and normalised in the vertex shader, so the CPU never touches per-sample geometry.
+class GlStatusGraph : public QOpenGLWidget, protected QOpenGLFunctions
+{
+    Q_OBJECT
+
+public:
+    explicit GlStatusGraph(QWidget* parent = nullptr);
+    ~GlStatusGraph() override;
+
+    // True when a hardware (non-software-rasterised) OpenGL context can be created.
+    static bool isSupported();
+
+public slots:
+    void updateData(const FrameSnapshot& frame);
+
+protected:
+    void initializeGL() override;
+    void paintGL() override;
+
+private:
+    void uploadProfile();
+
+    QOpenGLShaderProgram program_;
+    QOpenGLVertexArrayObject vao_;
+    QOpenGLBuffer index_buffer_;
+    QOpenGLBuffer value_buffer_;
+    QVector<float> profile_;
+    float max_value_ = 0.0f;
+    int uploaded_count_ = 0;
+    int index_count_ = 0;
+    bool profile_dirty_ = false;
+    int detection_count_ = 0;
+    // Pipeline stamps of the newest frame not yet painted; 0 once its paint is recorded.
+    qint64 pending_origin_us_ = 0;
+    qint64 pending_dispatch_us_ = 0;
+};
@@ -1,27 +1,29 @@
 #include "InputConfigurator.h"
 
+#include "CaptureIngest.h"
+#include "EndpointPool.h"
+#include "SweepDialog.h"
+
 #include <QBoxLayout>
+#include <QCheckBox>
 #include <QComboBox>
-#include <QDateTime>
 #include <QDir>
-#include <QFile>
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QLabel>
 #include <QLineEdit>
-#include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QPlainTextEdit>
-#include <QProcess>
 #include <QPushButton>
 #include <QRandomGenerator>
-#include <QRegularExpression>
+#include <QSignalBlocker>
 #include <QSpinBox>
 #include <QDoubleSpinBox>
 #include <QStringList>
+#include <QThread>
 #include <QUrl>
 
 #include <QtGlobal>
@@ -32,76 +34,39 @@ QString scenarioPath(const QString& root)
 {
     return QDir(root).filePath("simulator/configs");
 }
-
-QString readFile(const QString& path)
-{
-    QFile file(path);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return {};
-    }
-    return QString::fromUtf8(file.readAll());
-}
-
-template <typename T>
-T parseValue(const QString& contents, const QString& name, const T& fallback = T())
-{
-    const QRegularExpression rx(QStringLiteral("^%1:\\s*(\\d+)").arg(name), QRegularExpression::MultilineOption);
-    const auto match = rx.match(contents);
-    if (match.hasMatch()) {
-        return static_cast<T>(match.captured(1).toInt());
-    }
-    return fallback;
-}
-
-double parseFloatValue(const QString& contents, const QString& name, double fallback)
-{
-    const QRegularExpression rx(QStringLiteral("^%1:\\s*([+-]?\\d+(?:\\.\\d+)?)").arg(name),
-                                 QRegularExpression::MultilineOption);
-    const auto match = rx.match(contents);
-    if (match.hasMatch()) {
-        return match.captured(1).toDouble();
-    }
-    return fallback;
-}
-
-quint64 parseSeedValue(const QString& contents, const QString& name, quint64 fallback)
-{
-    const QRegularExpression rx(QStringLiteral("^%1:\\s*(\\d+)").arg(name), QRegularExpression::MultilineOption);
-    const auto match = rx.match(contents);
-    if (match.hasMatch()) {
-        return static_cast<quint64>(match.captured(1).toULongLong());
-    }
-    return fallback;
-}
-
-QString parseStringValue(const QString& contents, const QString& name)
-{
-    const QRegularExpression rx(QStringLiteral("^%1:\\s*(.+)").arg(name), QRegularExpression::MultilineOption);
-    const auto match = rx.match(contents);
-    if (match.hasMatch()) {
-        return match.captured(1).trimmed();
-    }
-    return QString();
-}
 } // namespace
 
-InputConfigurator::InputConfigurator(QWidget* parent)
+InputConfigurator::InputConfigurator(EndpointPool* network, const QUrl& bridgeUrl, QWidget* parent)
     : QGroupBox(tr("Offline Test Control"), parent)
     , root_path_edit_(new QLineEdit(this))
     , browse_button_(new QPushButton(tr("Browse"), this))
+    , engine_path_edit_(new QLineEdit(this))
     , start_button_(new QPushButton(tr("Start Engine"), this))
     , stop_button_(new QPushButton(tr("Stop Engine"), this))
     , scenario_combo_(new QComboBox(this))
     , run_button_(new QPushButton(tr("Run Scenario"), this))
+    , sweep_button_(new QPushButton(tr("Sweep..."), this))
     , taps_spin_(new QSpinBox(this))
     , range_spin_(new QSpinBox(this))
     , doppler_spin_(new QSpinBox(this))
     , frequency_spin_(new QDoubleSpinBox(this))
     , noise_spin_(new QDoubleSpinBox(this))
+    , workers_spin_(new QSpinBox(this))
     , log_output_(new QPlainTextEdit(this))
-    , server_process_(new QProcess(this))
-    , network_manager_(new QNetworkAccessManager(this))
+    , log_level_combo_(new QComboBox(this))
+    , log_sink_(new LogSink(log_output_, 2000, 100, this))
+    , engine_(new EngineController(this))
+    , network_(network)
+    , bridge_url_(bridgeUrl)
     , scenario_description_label_(new QLabel(tr("Select a scenario to load its metadata."), this))
+    , catalog_(new ScenarioCatalog(this))
+    , capture_path_edit_(new QLineEdit(this))
+    , capture_browse_button_(new QPushButton(tr("Browse"), this))
+    , capture_rate_spin_(new QDoubleSpinBox(this))
+    , capture_loop_check_(new QCheckBox(tr("Loop"), this))
+    , ingest_button_(new QPushButton(tr("Ingest Capture"), this))
+    , capture_status_label_(new QLabel(this))
+    , capture_ingest_(new CaptureIngest(network, bridgeEndpoint(QStringLiteral("/ingest")), this))
     , scenario_seed_(0)
 {
     root_path_edit_->setText(QDir::currentPath());
@@ -112,7 +77,12 @@ InputConfigurator::InputConfigurator(QWidget* parent)
     rootLayout->addWidget(root_path_edit_, 1);
     rootLayout->addWidget(browse_button_);
 
+    engine_path_edit_->setPlaceholderText(tr("Auto: target/release or target/debug, else cargo run"));
+    engine_path_edit_->setToolTip(tr("Simulator executable, absolute or relative to the project root"));
+
     auto* engineLayout = new QHBoxLayout();
+    engineLayout->addWidget(new QLabel(tr("Engine binary:"), this));
+    engineLayout->addWidget(engine_path_edit_, 1);
     engineLayout->addWidget(start_button_);
     engineLayout->addWidget(stop_button_);
 
@@ -120,6 +90,7 @@ InputConfigurator::InputConfigurator(QWidget* parent)
     scenarioLayout->addWidget(new QLabel(tr("Scenario"), this));
     scenarioLayout->addWidget(scenario_combo_);
     scenarioLayout->addWidget(run_button_);
+    scenarioLayout->addWidget(sweep_button_);
 
     taps_spin_->setRange(1, 32);
     taps_spin_->setValue(4);
@@ -135,6 +106,11 @@ InputConfigurator::InputConfigurator(QWidget* parent)
     noise_spin_->setRange(0.0, 0.5);
     noise_spin_->setSingleStep(0.01);
     noise_spin_->setValue(0.03);
+    workers_spin_->setRange(0, 256);
+    // 0 is the minimum, so the special text stands in for it.
+    workers_spin_->setSpecialValueText(tr("auto (%1)").arg(QThread::idealThreadCount()));
+    workers_spin_->setValue(0);
+    workers_spin_->setToolTip(tr("Threads the engine processes submissions on; applied when the engine starts"));
 
     scenario_description_label_->setWordWrap(true);
     scenario_description_label_->setStyleSheet("color: #cccccc;");
@@ -151,11 +127,41 @@ InputConfigurator::InputConfigurator(QWidget* parent)
     grid->addWidget(frequency_spin_, 1, 3);
     grid->addWidget(new QLabel(tr("Noise level"), this), 2, 0);
     grid->addWidget(noise_spin_, 2, 1);
+    grid->addWidget(new QLabel(tr("Workers"), this), 2, 2);
+    grid->addWidget(workers_spin_, 2, 3);
     grid->setColumnStretch(1, 1);
     grid->setColumnStretch(3, 1);
 
     log_output_->setReadOnly(true);
     log_output_->setMinimumHeight(120);
+    log_level_combo_->addItem(tr("Debug"), QVariant::fromValue(LogSink::Severity::Debug));
+    log_level_combo_->addItem(tr("Info"), QVariant::fromValue(LogSink::Severity::Info));
+    log_level_combo_->addItem(tr("Warnings"), QVariant::fromValue(LogSink::Severity::Warning));
+    log_level_combo_->addItem(tr("Errors"), QVariant::fromValue(LogSink::Severity::Error));
+    log_level_combo_->setCurrentIndex(log_level_combo_->findData(QVariant::fromValue(log_sink_->minimumSeverity())));
+
+    capture_path_edit_->setPlaceholderText(tr("PRI capture: one PriPayload JSON object per line"));
+    capture_rate_spin_->setRange(0.0, 1000.0);
+    capture_rate_spin_->setDecimals(1);
+    capture_rate_spin_->setValue(10.0);
+    capture_rate_spin_->setSuffix(tr(" fps"));
+    // 0 is the minimum, so the special text stands in for it.
+    capture_rate_spin_->setSpecialValueText(tr("max"));
+    capture_rate_spin_->setToolTip(tr("Target upload rate; \"max\" sends as fast as the bridge acknowledges"));
+    capture_status_label_->setStyleSheet("color: #aaaaaa;");
+
+    auto* captureLayout = new QHBoxLayout();
+    captureLayout->addWidget(new QLabel(tr("Capture:"), this));
+    captureLayout->addWidget(capture_path_edit_, 1);
+    captureLayout->addWidget(capture_browse_button_);
+    captureLayout->addWidget(capture_rate_spin_);
+    captureLayout->addWidget(capture_loop_check_);
+    captureLayout->addWidget(ingest_button_);
+
+    auto* logLayout = new QHBoxLayout();
+    logLayout->addWidget(new QLabel(tr("Log level"), this));
+    logLayout->addWidget(log_level_combo_);
+    logLayout->addStretch(1);
 
     auto* layout = new QVBoxLayout(this);
     layout->addLayout(rootLayout);
@@ -163,24 +169,54 @@ InputConfigurator::InputConfigurator(QWidget* parent)
     layout->addLayout(scenarioLayout);
     layout->addWidget(scenario_description_label_);
     layout->addLayout(grid);
+    layout->addLayout(captureLayout);
+    layout->addWidget(capture_status_label_);
+    layout->addLayout(logLayout);
     layout->addWidget(log_output_);
 
     connect(browse_button_, &QPushButton::clicked, this, &InputConfigurator::onBrowseRoot);
     connect(start_button_, &QPushButton::clicked, this, &InputConfigurator::onStartServer);
     connect(stop_button_, &QPushButton::clicked, this, &InputConfigurator::onStopServer);
     connect(run_button_, &QPushButton::clicked, this, &InputConfigurator::onRunScenario);
-    connect(server_process_, &QProcess::readyReadStandardOutput, this, &InputConfigurator::onServerOutput);
-    connect(server_process_, &QProcess::readyReadStandardError, this, &InputConfigurator::onServerOutput);
-    connect(server_process_, QOverload<QProcess::ProcessError>::of(&QProcess::errorOccurred),
-            this, &InputConfigurator::onServerError);
-    connect(server_process_, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, [this](int code, QProcess::ExitStatus) {
-        Q_UNUSED(code);
-        Q_UNUSED(QProcess::ExitStatus);
-        logMessage(tr("Simulator exited."));
+    connect(sweep_button_, &QPushButton::clicked, this, &InputConfigurator::onRunSweep);
+    connect(capture_browse_button_, &QPushButton::clicked, this, &InputConfigurator::onBrowseCapture);
+    connect(ingest_button_, &QPushButton::clicked, this, &InputConfigurator::onIngestCapture);
+    connect(capture_ingest_, &CaptureIngest::statisticsChanged, this, [this](const CaptureIngest::Statistics& stats) {
+        capture_status_label_->setText(tr("%1 of %2 frames sent | %3 acknowledged | %4 failed | %5 fps | %6 MiB")
+                                           .arg(stats.sent)
+                                           .arg(stats.frames)
+                                           .arg(stats.acknowledged)
+                                           .arg(stats.failed)
+                                           .arg(stats.fps, 0, 'f', 1)
+                                           .arg(stats.bytes / (1024.0 * 1024.0), 0, 'f', 1));
+    });
+    connect(capture_ingest_, &CaptureIngest::finished, this, [this]() {
+        const auto stats = capture_ingest_->statistics();
+        logMessage(tr("Capture ingest finished: %1 frames acknowledged, %2 failed, %3 fps average.")
+                       .arg(stats.acknowledged)
+                       .arg(stats.failed)
+                       .arg(stats.fps, 0, 'f', 1),
+                   stats.failed > 0 ? LogSink::Severity::Warning : LogSink::Severity::Info);
+        updateControls();
+    });
+    connect(log_level_combo_, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
+        log_sink_->setMinimumSeverity(log_level_combo_->itemData(index).value<LogSink::Severity>());
+    });
+    // Engine output is merged stdout/stderr; the sink splits it into lines.
+    connect(engine_, &EngineController::outputReceived, log_sink_, &LogSink::appendProcessOutput);
+    connect(engine_, &EngineController::message, this, &InputConfigurator::logMessage);
+    connect(engine_, &EngineController::stateChanged, this, [this](EngineController::State state) {
+        if (state == EngineController::State::Stopped) {
+            log_sink_->flushPartialLine();
+            capture_ingest_->stop();
+        }
         updateControls();
     });
 
-    populateScenarioList();
+    connect(catalog_, &ScenarioCatalog::entriesChanged, this, &InputConfigurator::onCatalogChanged);
+    connect(catalog_, &ScenarioCatalog::directoryMissing, this, [this](const QString& path) {
+        logMessage(tr("Scenario directory not found: %1").arg(path), LogSink::Severity::Warning);
+    });
     connect(scenario_combo_, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
         const QString path = scenario_combo_->itemData(index).toString();
         if (!path.isEmpty()) {
@@ -188,19 +224,12 @@ InputConfigurator::InputConfigurator(QWidget* parent)
             logMessage(tr("Loaded scenario %1").arg(QFileInfo(path).fileName()));
         }
     });
-    if (scenario_combo_->count() > 0) {
-        scenario_combo_->setCurrentIndex(0);
-    }
+    // The first scenario is selected once the background scan lists it.
+    populateScenarioList();
     updateControls();
 }
 
-InputConfigurator::~InputConfigurator()
-{
-    if (server_process_->state() != QProcess::NotRunning) {
-        server_process_->terminate();
-        server_process_->waitForFinished(1000);
-    }
-}
+InputConfigurator::~InputConfigurator() = default;
 
 void InputConfigurator::onBrowseRoot()
 {
@@ -214,173 +243,215 @@ void InputConfigurator::onBrowseRoot()
 
 void InputConfigurator::onStartServer()
 {
-    if (server_process_->state() != QProcess::NotRunning) {
-        logMessage(tr("Server already running."));
-        return;
-    }
-
     const QString root = root_path_edit_->text();
     if (root.isEmpty()) {
-        logMessage(tr("Set the project root before starting the engine."));
-        return;
-    }
-
-    const QString cargo = QStringLiteral("cargo");
-    const QStringList args = {QStringLiteral("run"),
-                              QStringLiteral("--bin"),
-                              QStringLiteral("simulator"),
-                              QStringLiteral("--"),
-                              QStringLiteral("--serve")};
-    server_process_->setWorkingDirectory(root);
-    server_process_->setProcessChannelMode(QProcess::MergedChannels);
-    server_process_->start(cargo, args);
-    if (!server_process_->waitForStarted(3000)) {
-        logMessage(tr("Failed to start simulator server. Is Rust/Cargo installed?"));
+        logMessage(tr("Set the project root before starting the engine."), LogSink::Severity::Warning);
         return;
     }
 
     logMessage(tr("Simulator server starting..."));
-    updateControls();
+    engine_->setWorkingDirectory(root);
+    engine_->setExecutable(engine_path_edit_->text());
+    engine_->setWorkers(workers_spin_->value());
+    // The engine serves the bridge this configurator submits to; a URL without a port is 80.
+    engine_->setBridgePort(static_cast<quint16>(bridge_url_.port(80)));
+    engine_->start();
 }
 
 void InputConfigurator::onStopServer()
 {
-    if (server_process_->state() == QProcess::NotRunning) {
+    if (engine_->state() == EngineController::State::Stopped) {
         logMessage(tr("Server already stopped."));
         return;
     }
-    server_process_->terminate();
-    if (!server_process_->waitForFinished(2000)) {
-        server_process_->kill();
-    }
-    logMessage(tr("Simulator server stopped."));
-    updateControls();
+    engine_->stop();
 }
 
 void InputConfigurator::onRunScenario()
 {
-    if (server_process_->state() == QProcess::NotRunning) {
-        logMessage(tr("Start the simulator engine before running scenarios."));
+    if (engine_->state() != EngineController::State::Running) {
+        logMessage(tr("Start the simulator engine before running scenarios."), LogSink::Severity::Warning);
         return;
     }
 
-    const int taps = taps_spin_->value();
-    const int range_bins = range_spin_->value();
-    const int doppler_bins = doppler_spin_->value();
-    const double frequency = frequency_spin_->value();
-    const double noise = noise_spin_->value();
-    quint64 seed = scenario_seed_;
-    if (seed == 0) {
-        seed = QRandomGenerator::global()->generate64();
-    }
-
-    QJsonObject payload;
-    payload.insert(QStringLiteral("taps"), taps);
-    payload.insert(QStringLiteral("range_bins"), range_bins);
-    payload.insert(QStringLiteral("doppler_bins"), doppler_bins);
-    payload.insert(QStringLiteral("frequency"), frequency);
-    payload.insert(QStringLiteral("noise"), noise);
-    payload.insert(QStringLiteral("seed"), static_cast<qint64>(seed));
-
-    if (!current_scenario_path_.isEmpty()) {
-        payload.insert(QStringLiteral("scenario"), QFileInfo(current_scenario_path_).baseName());
-    }
-    if (!current_scenario_description_.isEmpty()) {
-        payload.insert(QStringLiteral("description"), current_scenario_description_);
-    }
+    const Scenario scenario = currentScenario();
+    const quint64 seed = scenario.seed != 0 ? scenario.seed : QRandomGenerator::global()->generate64();
+    const QJsonObject payload = scenario.toGeneratorConfig(seed);
 
-    logMessage(tr("Submitting offline configuration (taps=%1, range=%2, doppler=%3).")
-               .arg(taps)
-               .arg(range_bins)
-               .arg(doppler_bins));
+    const QString requestId = QStringLiteral("run-%1").arg(++run_counter_);
+    logMessage(tr("Submitting offline configuration %1 (taps=%2, range=%3, doppler=%4).")
+               .arg(requestId)
+               .arg(scenario.taps)
+               .arg(scenario.range_bins)
+               .arg(scenario.doppler_bins));
 
-    const QUrl url(QStringLiteral("http://127.0.0.1:9000/ingest-config"));
-    QNetworkRequest request(url);
+    QNetworkRequest request = network_->request(bridgeEndpoint(QStringLiteral("/ingest-config")));
     request.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("application/json"));
-    auto* reply = network_manager_->post(request, QJsonDocument(payload).toJson());
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        const bool ok = reply->error() == QNetworkReply::NoError;
-        if (ok) {
-            logMessage(tr("Scenario submitted successfully."));
+    request.setRawHeader("X-Request-Id", requestId.toUtf8());
+    auto* reply = network_->post(request, QJsonDocument(payload).toJson());
+    // Runs execute in parallel on the engine, so replies are reported by their ID.
+    connect(reply, &QNetworkReply::finished, this, [this, reply, requestId]() {
+        const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (reply->error() == QNetworkReply::NoError) {
+            const QJsonObject body = QJsonDocument::fromJson(reply->readAll()).object();
+            logMessage(tr("Scenario %1 finished with %2 detections.")
+                           .arg(body.value(QStringLiteral("request_id")).toString(requestId))
+                           .arg(body.value(QStringLiteral("detections")).toInt()));
+        } else if (status == 503) {
+            logMessage(tr("Scenario %1 rejected: every engine worker is busy and its queue is full.").arg(requestId),
+                       LogSink::Severity::Warning);
         } else {
-            logMessage(tr("Failed to submit scenario: %1").arg(reply->errorString()));
+            logMessage(tr("Failed to submit scenario %1: %2").arg(requestId, reply->errorString()),
+                       LogSink::Severity::Error);
         }
         reply->deleteLater();
     });
 }
 
-void InputConfigurator::onServerOutput()
+void InputConfigurator::onBrowseCapture()
 {
-    const QByteArray output = server_process_->readAllStandardOutput();
-    if (!output.isEmpty()) {
-        logMessage(QString::fromUtf8(output).trimmed());
+    const QString selected = QFileDialog::getOpenFileName(this, tr("Select PRI Capture"), root_path_edit_->text(),
+                                                          tr("PRI captures (*.ndjson *.jsonl);;All files (*)"));
+    if (!selected.isEmpty()) {
+        capture_path_edit_->setText(selected);
     }
 }
 
-void InputConfigurator::onServerError(QProcess::ProcessError error)
+void InputConfigurator::onIngestCapture()
 {
-    Q_UNUSED(error)
-    logMessage(tr("Simulator engine reported an error."));
+    if (capture_ingest_->isRunning()) {
+        capture_ingest_->stop();
+        return;
+    }
+    if (engine_->state() != EngineController::State::Running) {
+        logMessage(tr("Start the simulator engine before ingesting a capture."), LogSink::Severity::Warning);
+        return;
+    }
+
+    const QString path = QDir(root_path_edit_->text()).absoluteFilePath(capture_path_edit_->text().trimmed());
+    QString error;
+    if (capture_path_edit_->text().trimmed().isEmpty() || !capture_ingest_->open(path, &error)) {
+        logMessage(tr("Cannot open capture %1: %2").arg(path, error.isEmpty() ? tr("no file selected") : error),
+                   LogSink::Severity::Error);
+        return;
+    }
+    capture_ingest_->setRate(capture_rate_spin_->value());
+    capture_ingest_->setLoop(capture_loop_check_->isChecked());
+    logMessage(tr("Ingesting %1 frames from %2.").arg(capture_ingest_->frameCount()).arg(QFileInfo(path).fileName()));
+    capture_ingest_->start();
     updateControls();
 }
 
-void InputConfigurator::logMessage(const QString& message)
+QUrl InputConfigurator::bridgeEndpoint(const QString& path) const
+{
+    QUrl url = bridge_url_;
+    QString prefix = url.path();
+    if (prefix.endsWith(QLatin1Char('/'))) {
+        prefix.chop(1);
+    }
+    url.setPath(prefix + path);
+    return url;
+}
+
+void InputConfigurator::logMessage(const QString& message, LogSink::Severity severity)
+{
+    log_sink_->append(severity, message);
+}
+
+void InputConfigurator::onRunSweep()
 {
-    log_output_->appendPlainText(QStringLiteral("[%1] %2")
-                                 .arg(QDateTime::currentDateTime().toString(Qt::ISODate), message));
+    if (!sweep_dialog_) {
+        sweep_dialog_ = new SweepDialog(network_, bridgeEndpoint(QStringLiteral("/ingest-config")), this);
+    }
+    sweep_dialog_->setBaseScenario(currentScenario());
+    sweep_dialog_->setScenarioDirectory(scenarioPath(root_path_edit_->text()));
+    sweep_dialog_->show();
+    sweep_dialog_->raise();
+    sweep_dialog_->activateWindow();
 }
 
 void InputConfigurator::loadScenario(const QString& path)
 {
-    const QString contents = readFile(path);
-    if (contents.isEmpty()) {
+    const ScenarioCatalog::Entry* entry = catalog_->find(path);
+    if (!entry) {
         return;
     }
+    const Scenario scenario = entry->parsed.applyTo(currentScenario());
 
-    const int taps = parseValue<int>(contents, QStringLiteral("taps"), taps_spin_->value());
-    const int range_bins = parseValue<int>(contents, QStringLiteral("range_bins"), range_spin_->value());
-    const int doppler_bins = parseValue<int>(contents, QStringLiteral("doppler_bins"), doppler_spin_->value());
-    const double frequency = parseFloatValue(contents, QStringLiteral("frequency"), frequency_spin_->value());
-    const double noise = parseFloatValue(contents, QStringLiteral("noise"), noise_spin_->value());
-    const quint64 seed = parseSeedValue(contents, QStringLiteral("seed"), 0);
-    const QString description = parseStringValue(contents, QStringLiteral("description"));
-
-    taps_spin_->setValue(taps);
-    range_spin_->setValue(range_bins);
-    doppler_spin_->setValue(doppler_bins);
-    frequency_spin_->setValue(frequency);
-    noise_spin_->setValue(noise);
+    taps_spin_->setValue(scenario.taps);
+    range_spin_->setValue(scenario.range_bins);
+    doppler_spin_->setValue(scenario.doppler_bins);
+    frequency_spin_->setValue(scenario.frequency);
+    noise_spin_->setValue(scenario.noise);
 
     current_scenario_path_ = path;
-    scenario_seed_ = seed;
-    current_scenario_description_ = description;
-    if (!description.isEmpty()) {
-        scenario_description_label_->setText(description);
+    current_scenario_modified_ = entry->modified;
+    scenario_seed_ = scenario.seed;
+    current_scenario_description_ = scenario.description;
+    if (!scenario.description.isEmpty()) {
+        scenario_description_label_->setText(scenario.description);
     } else {
         scenario_description_label_->setText(tr("Loaded %1").arg(QFileInfo(path).fileName()));
     }
 }
 
+Scenario InputConfigurator::currentScenario() const
+{
+    Scenario scenario;
+    scenario.path = current_scenario_path_;
+    scenario.taps = taps_spin_->value();
+    scenario.range_bins = range_spin_->value();
+    scenario.doppler_bins = doppler_spin_->value();
+    scenario.frequency = frequency_spin_->value();
+    scenario.noise = noise_spin_->value();
+    scenario.seed = scenario_seed_;
+    scenario.description = current_scenario_description_;
+    return scenario;
+}
+
 void InputConfigurator::populateScenarioList()
 {
-    scenario_combo_->clear();
-    const QString dirPath = scenarioPath(root_path_edit_->text());
-    const QDir dir(dirPath);
-    if (!dir.exists()) {
-        logMessage(tr("Scenario directory not found: %1").arg(dirPath));
-        return;
+    catalog_->setDirectory(scenarioPath(root_path_edit_->text()));
+}
+
+void InputConfigurator::onCatalogChanged()
+{
+    const QString selected = scenario_combo_->currentData().toString();
+    {
+        const QSignalBlocker blocker(scenario_combo_);
+        scenario_combo_->clear();
+        for (const ScenarioCatalog::Entry& entry : catalog_->entries()) {
+            scenario_combo_->addItem(entry.file_name, entry.path);
+        }
+        const int kept = scenario_combo_->findData(selected);
+        if (kept >= 0) {
+            scenario_combo_->setCurrentIndex(kept);
+        }
     }
 
-    const auto files = dir.entryInfoList(QStringList{QStringLiteral("*.yaml")}, QDir::Files);
-    for (const auto& file : files) {
-        scenario_combo_->addItem(file.fileName(), file.absoluteFilePath());
+    const ScenarioCatalog::Entry* current = catalog_->find(selected);
+    if (current) {
+        if (current->path == current_scenario_path_ && current->modified != current_scenario_modified_) {
+            loadScenario(current->path);
+            logMessage(tr("Reloaded scenario %1").arg(current->file_name));
+        }
+    } else if (scenario_combo_->count() > 0) {
+        scenario_combo_->setCurrentIndex(-1);
+        scenario_combo_->setCurrentIndex(0);
     }
 }
 
 void InputConfigurator::updateControls()
 {
-    const bool running = server_process_->state() != QProcess::NotRunning;
-    start_button_->setEnabled(!running);
-    stop_button_->setEnabled(running);
-    run_button_->setEnabled(running);
+    const EngineController::State state = engine_->state();
+    start_button_->setEnabled(state == EngineController::State::Stopped);
+    start_button_->setText(state == EngineController::State::Starting ? tr("Starting...") : tr("Start Engine"));
+    stop_button_->setEnabled(state == EngineController::State::Starting || state == EngineController::State::Running);
+    stop_button_->setText(state == EngineController::State::Stopping ? tr("Stopping...") : tr("Stop Engine"));
+    run_button_->setEnabled(state == EngineController::State::Running);
+    sweep_button_->setEnabled(state == EngineController::State::Running);
+    workers_spin_->setEnabled(state == EngineController::State::Stopped);
+    const bool ingesting = capture_ingest_->isRunning();
+    ingest_button_->setEnabled(ingesting || state == EngineController::State::Running);
+    ingest_button_->setText(ingesting ? tr("Stop Ingest") : tr("Ingest Capture"));
 }
@@ -1,21 +1,34 @@
 #pragma once
 
+#include "EngineController.h"
+#include "LogSink.h"
+#include "ScenarioCatalog.h"
+#include "ScenarioFile.h"
+
 #include <QGroupBox>
+#include <QUrl>
 
+class CaptureIngest;
+class EndpointPool;
+class QCheckBox;
 class QComboBox;
 class QDoubleSpinBox;
+class QLabel;
 class QLineEdit;
 class QPlainTextEdit;
 class QPushButton;
-class QProcess;
-class QNetworkAccessManager;
+class QSpinBox;
+class SweepDialog;
 
 class InputConfigurator : public QGroupBox
 {
     Q_OBJECT
 
 public:
-    explicit InputConfigurator(QWidget* parent = nullptr);
+    // `network` carries /ingest-config submissions and must outlive the configurator.
+    // Scenarios, sweeps and captures are submitted to the bridge rooted at `bridgeUrl`,
+    // and a locally started engine listens on its port.
+    InputConfigurator(EndpointPool* network, const QUrl& bridgeUrl, QWidget* parent = nullptr);
     ~InputConfigurator() override;
 
 private slots:
@@ -23,31 +36,57 @@ private slots:
     void onStartServer();
     void onStopServer();
     void onRunScenario();
-    void onServerOutput();
-    void onServerError(QProcess::ProcessError error);
+    void onRunSweep();
+    void onBrowseCapture();
+    void onIngestCapture();
 
 private:
-    void logMessage(const QString& message);
+    void logMessage(const QString& message, LogSink::Severity severity = LogSink::Severity::Info);
     void loadScenario(const QString& path);
+    // Scenario described by the current controls.
+    Scenario currentScenario() const;
     void populateScenarioList();
+    // Refills scenario_combo_ from the catalogue, keeping the current pick when it remains.
+    void onCatalogChanged();
     void updateControls();
+    // `path` under the bridge root, keeping any path prefix the root carries.
+    QUrl bridgeEndpoint(const QString& path) const;
 
     QLineEdit* root_path_edit_;
     QPushButton* browse_button_;
+    QLineEdit* engine_path_edit_;
     QPushButton* start_button_;
     QPushButton* stop_button_;
     QComboBox* scenario_combo_;
     QPushButton* run_button_;
+    QPushButton* sweep_button_;
     QSpinBox* taps_spin_;
     QSpinBox* range_spin_;
     QSpinBox* doppler_spin_;
     QDoubleSpinBox* frequency_spin_;
     QDoubleSpinBox* noise_spin_;
+    QSpinBox* workers_spin_;
     QPlainTextEdit* log_output_;
-    QProcess* server_process_;
-    QNetworkAccessManager* network_manager_;
+    QComboBox* log_level_combo_;
+    LogSink* log_sink_;
+    EngineController* engine_;
+    EndpointPool* network_;
+    QUrl bridge_url_;
     QLabel* scenario_description_label_;
+    SweepDialog* sweep_dialog_ = nullptr;
+    ScenarioCatalog* catalog_;
+    QLineEdit* capture_path_edit_;
+    QPushButton* capture_browse_button_;
+    QDoubleSpinBox* capture_rate_spin_;
+    QCheckBox* capture_loop_check_;
+    QPushButton* ingest_button_;
+    QLabel* capture_status_label_;
+    CaptureIngest* capture_ingest_;
     QString current_scenario_path_;
+    // Modification time of the loaded deck, so an edit on disk reloads the controls.
+    QDateTime current_scenario_modified_;
     QString current_scenario_description_;
     quint64 scenario_seed_;
+    // Numbers the X-Request-Id of each Run Scenario submission.
+    int run_counter_ = 0;
 };
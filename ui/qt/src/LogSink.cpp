@@ -0,0 +1,110 @@
+#include "LogSink.h"
+
+#include <QDateTime>
+#include <QPlainTextEdit>
+#include <QStringList>
+
+LogSink::LogSink(QPlainTextEdit* view, int maxLines, int flushIntervalMs, QObject* parent)
+    : QObject(parent)
+    , view_(view)
+    , history_(qMax(1, maxLines))
+{
+    // The widget drops its oldest blocks itself once it reaches the cap.
+    view_->setMaximumBlockCount(history_.capacity());
+    flush_timer_.setSingleShot(true);
+    flush_timer_.setInterval(flushIntervalMs);
+    connect(&flush_timer_, &QTimer::timeout, this, &LogSink::flush);
+}
+
+void LogSink::append(Severity severity, const QString& message)
+{
+    history_.append(Entry{severity, QStringLiteral("[%1] %2").arg(timestamp(), message)});
+    if (!history_.areIndexesValid()) {
+        history_.normalizeIndexes();
+    }
+    pending_ = qMin(pending_ + 1, history_.count());
+    if (!flush_timer_.isActive()) {
+        flush_timer_.start();
+    }
+}
+
+void LogSink::appendProcessOutput(const QByteArray& chunk)
+{
+    partial_line_.append(chunk);
+    qsizetype start = 0;
+    for (qsizetype end = partial_line_.indexOf('\n'); end >= 0; end = partial_line_.indexOf('\n', start)) {
+        const QString line = QString::fromUtf8(partial_line_.constData() + start, end - start).trimmed();
+        if (!line.isEmpty()) {
+            append(classify(line), line);
+        }
+        start = end + 1;
+    }
+    partial_line_.remove(0, start);
+}
+
+void LogSink::flushPartialLine()
+{
+    const QString line = QString::fromUtf8(partial_line_).trimmed();
+    partial_line_.clear();
+    if (!line.isEmpty()) {
+        append(classify(line), line);
+    }
+}
+
+void LogSink::setMinimumSeverity(Severity severity)
+{
+    if (severity == minimum_) {
+        return;
+    }
+    minimum_ = severity;
+    // Re-render the retained history under the new filter.
+    flush_timer_.stop();
+    view_->clear();
+    pending_ = history_.count();
+    flush();
+}
+
+LogSink::Severity LogSink::classify(const QString& line)
+{
+    if (line.contains(QLatin1String("error"), Qt::CaseInsensitive) || line.contains(QLatin1String("panicked"))) {
+        return Severity::Error;
+    }
+    if (line.contains(QLatin1String("warning"), Qt::CaseInsensitive)) {
+        return Severity::Warning;
+    }
+    // The bridge prints one of these per published frame.
+    if (line.startsWith(QLatin1String("[GUI] power profile points"))) {
+        return Severity::Debug;
+    }
+    return Severity::Info;
+}
+
+const QString& LogSink::timestamp()
+{
+    // Formatting a date is far dearer than reading the clock, so do it once per second.
+    const qint64 second = QDateTime::currentSecsSinceEpoch();
+    if (second != stamp_second_) {
+        stamp_second_ = second;
+        stamp_ = QDateTime::fromSecsSinceEpoch(second).toString(Qt::ISODate);
+    }
+    return stamp_;
+}
+
+void LogSink::flush()
+{
+    if (pending_ == 0) {
+        return;
+    }
+    QStringList lines;
+    lines.reserve(pending_);
+    for (int i = history_.lastIndex() - pending_ + 1; i <= history_.lastIndex(); ++i) {
+        const Entry& entry = history_.at(i);
+        if (entry.severity >= minimum_) {
+            lines.append(entry.text);
+        }
+    }
+    pending_ = 0;
+    if (!lines.isEmpty()) {
+        view_->appendPlainText(lines.join(QLatin1Char('\n')));
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QByteArray>
+#include <QContiguousCache>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+class QPlainTextEdit;
+
+// Batched, bounded log backend for a QPlainTextEdit. Lines are kept in a fixed-size ring
+// and flushed to the widget in one append per timer tick, and the widget itself is capped
+// at the same block count, so a chatty engine costs the same per frame for the whole session.
+class LogSink : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Severity
+    {
+        Debug,
+        Info,
+        Warning,
+        Error
+    };
+    Q_ENUM(Severity)
+
+    explicit LogSink(QPlainTextEdit* view, int maxLines = 2000, int flushIntervalMs = 100,
+                     QObject* parent = nullptr);
+
+    void append(Severity severity, const QString& message);
+    // Raw process output: split on newlines, keeping any partial last line for the next chunk.
+    void appendProcessOutput(const QByteArray& chunk);
+    void flushPartialLine();
+
+    Severity minimumSeverity() const { return minimum_; }
+    void setMinimumSeverity(Severity severity);
+
+    static Severity classify(const QString& line);
+
+private:
+    struct Entry
+    {
+        Severity severity;
+        QString text;
+    };
+
+    const QString& timestamp();
+    void flush();
+
+    QPlainTextEdit* view_;
+    QTimer flush_timer_;
+    QContiguousCache<Entry> history_;
+    // Number of newest history entries not yet written to the view.
+    int pending_ = 0;
+    QByteArray partial_line_;
+    Severity minimum_ = Severity::Info;
+    qint64 stamp_second_ = -1;
+    QString stamp_;
+};
@@ -0,0 +1,697 @@
+#include "ProfileKernels.h"
+
+#include <QByteArray>
+#include <QtGlobal>
+#include <cstring>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define GMTI_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC accepts AVX2 intrinsics in any function; only the dispatch decides whether they run.
+#define GMTI_TARGET_AVX2
+#else
+#define GMTI_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define GMTI_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+static_assert(sizeof(QPointF) == 2 * sizeof(double), "toScreen writes QPointF as an x, y pair of doubles");
+
+namespace
+{
+constexpr float kPowerFloor = 1e-12f;
+constexpr float kLnToDb = 4.34294481903251828f; // 10 / ln(10)
+constexpr float kSqrtHalf = 0.70710678118654752f;
+// ln(2) split so e * kLn2Hi is exact for any float exponent.
+constexpr float kLn2Hi = 0.693359375f;
+constexpr float kLn2Lo = -2.12194440e-4f;
+// Cephes logf: ln(1 + x) = x - x^2 / 2 + x^3 P(x) for x in [sqrt(1/2) - 1, sqrt(2) - 1).
+constexpr float kLogP[] = {7.0376836292e-2f,  -1.1514610310e-1f, 1.1676998740e-1f,
+                           -1.2420140846e-1f, 1.4249322787e-1f,  -1.6668057665e-1f,
+                           2.0000714765e-1f,  -2.4999993993e-1f, 3.3333331174e-1f};
+constexpr int kLogTerms = sizeof(kLogP) / sizeof(kLogP[0]);
+constexpr float kLutTop = 255.0f;
+constexpr float kInf = std::numeric_limits<float>::infinity();
+
+struct Span
+{
+    int begin;
+    int end;
+};
+
+inline Span columnSpan(int column, int samples, int columns)
+{
+    const int begin = static_cast<int>(static_cast<qint64>(column) * samples / columns);
+    const int end = qMax(begin + 1, static_cast<int>(static_cast<qint64>(column + 1) * samples / columns));
+    return {begin, end};
+}
+
+// --- Scalar ------------------------------------------------------------------------------
+// The vector versions below perform exactly these operations in the same order. Each
+// comparison keeps the accumulator when the sample is NaN, as SSE max/min do with the
+// sample as first operand and NEON maxnm/minnm always do. Accumulators start at -/+infinity
+// rather than at the first sample, so a NaN there cannot stick either.
+
+float maxScalar(const float* data, int count)
+{
+    if (count <= 0) {
+        return 0.0f;
+    }
+    float peak = -kInf;
+    for (int i = 0; i < count; ++i) {
+        peak = data[i] > peak ? data[i] : peak;
+    }
+    return peak;
+}
+
+void spanMinMaxScalar(const float* data, int count, float& low, float& high)
+{
+    low = kInf;
+    high = -kInf;
+    for (int i = 0; i < count; ++i) {
+        low = data[i] < low ? data[i] : low;
+        high = data[i] > high ? data[i] : high;
+    }
+}
+
+void columnMinMaxScalar(const float* data, int samples, int columns, float scale, float* levels)
+{
+    for (int column = 0; column < columns; ++column) {
+        const Span span = columnSpan(column, samples, columns);
+        float low;
+        float high;
+        spanMinMaxScalar(data + span.begin, span.end - span.begin, low, high);
+        levels[2 * column] = low * scale;
+        levels[2 * column + 1] = high * scale;
+    }
+}
+
+void columnMaxScalar(const float* data, int samples, int columns, float* out)
+{
+    for (int column = 0; column < columns; ++column) {
+        const Span span = columnSpan(column, samples, columns);
+        out[column] = maxScalar(data + span.begin, span.end - span.begin);
+    }
+}
+
+void scaleScalar(const float* data, int count, float scale, float* out)
+{
+    for (int i = 0; i < count; ++i) {
+        out[i] = data[i] * scale;
+    }
+}
+
+float decibelsScalar(float value)
+{
+    value = value > kPowerFloor ? value : kPowerFloor;
+    quint32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    // value is positive and normal: value = m * 2^e with m in [0.5, 1).
+    float e = static_cast<float>(static_cast<int>(bits >> 23) - 126);
+    bits = (bits & 0x007fffffu) | 0x3f000000u;
+    float m;
+    std::memcpy(&m, &bits, sizeof(m));
+    float x;
+    if (m < kSqrtHalf) {
+        e -= 1.0f;
+        x = m + m - 1.0f;
+    } else {
+        x = m - 1.0f;
+    }
+    const float z = x * x;
+    float p = kLogP[0];
+    for (int i = 1; i < kLogTerms; ++i) {
+        p = p * x + kLogP[i];
+    }
+    float y = x * z * p;
+    y += kLn2Lo * e;
+    y += -0.5f * z;
+    return (x + y + kLn2Hi * e) * kLnToDb;
+}
+
+void toDecibelsScalar(const float* data, int count, float* out)
+{
+    for (int i = 0; i < count; ++i) {
+        out[i] = decibelsScalar(data[i]);
+    }
+}
+
+inline int lutIndex(float db, float floorDb, float scale)
+{
+    float level = (db - floorDb) * scale;
+    level = level > 0.0f ? level : 0.0f;
+    level = level < kLutTop ? level : kLutTop;
+    return static_cast<int>(level);
+}
+
+void colourMapScalar(const float* db, int count, float floorDb, float scale, const QRgb* lut, QRgb* out)
+{
+    for (int i = 0; i < count; ++i) {
+        out[i] = lut[lutIndex(db[i], floorDb, scale)];
+    }
+}
+
+void toScreenScalar(const float* levels, int count, int pointsPerX, double left, double dx, double bottom,
+                    double height, QPointF* out)
+{
+    for (int i = 0; i < count; ++i) {
+        out[i] = QPointF(left + dx * (i / pointsPerX), bottom - levels[i] * height);
+    }
+}
+
+// --- SSE2 / AVX2 -------------------------------------------------------------------------
+#ifdef GMTI_KERNELS_X86
+
+float horizontalMax(__m128 v)
+{
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(v);
+}
+
+float horizontalMin(__m128 v)
+{
+    v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(v);
+}
+
+float maxSse2(const float* data, int count)
+{
+    if (count < 8) {
+        return maxScalar(data, count);
+    }
+    __m128 peak = _mm_set1_ps(-kInf);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        peak = _mm_max_ps(_mm_loadu_ps(data + i), peak);
+    }
+    float result = horizontalMax(peak);
+    for (; i < count; ++i) {
+        result = data[i] > result ? data[i] : result;
+    }
+    return result;
+}
+
+void spanMinMaxSse2(const float* data, int count, float& low, float& high)
+{
+    // Typical spans are a handful of bins, where the scalar loop is already the fastest.
+    if (count < 8) {
+        spanMinMaxScalar(data, count, low, high);
+        return;
+    }
+    __m128 lows = _mm_set1_ps(kInf);
+    __m128 highs = _mm_set1_ps(-kInf);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 v = _mm_loadu_ps(data + i);
+        lows = _mm_min_ps(v, lows);
+        highs = _mm_max_ps(v, highs);
+    }
+    low = horizontalMin(lows);
+    high = horizontalMax(highs);
+    for (; i < count; ++i) {
+        low = data[i] < low ? data[i] : low;
+        high = data[i] > high ? data[i] : high;
+    }
+}
+
+void columnMinMaxSse2(const float* data, int samples, int columns, float scale, float* levels)
+{
+    for (int column = 0; column < columns; ++column) {
+        const Span span = columnSpan(column, samples, columns);
+        float low;
+        float high;
+        spanMinMaxSse2(data + span.begin, span.end - span.begin, low, high);
+        levels[2 * column] = low * scale;
+        levels[2 * column + 1] = high * scale;
+    }
+}
+
+void columnMaxSse2(const float* data, int samples, int columns, float* out)
+{
+    for (int column = 0; column < columns; ++column) {
+        const Span span = columnSpan(column, samples, columns);
+        out[column] = maxSse2(data + span.begin, span.end - span.begin);
+    }
+}
+
+void scaleSse2(const float* data, int count, float scale, float* out)
+{
+    const __m128 factor = _mm_set1_ps(scale);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(data + i), factor));
+    }
+    scaleScalar(data + i, count - i, scale, out + i);
+}
+
+__m128 decibelsSse2(__m128 value)
+{
+    value = _mm_max_ps(value, _mm_set1_ps(kPowerFloor));
+    const __m128i bits = _mm_castps_si128(value);
+    __m128 e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(126)));
+    const __m128 m = _mm_castsi128_ps(
+        _mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f000000)));
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 small = _mm_cmplt_ps(m, _mm_set1_ps(kSqrtHalf));
+    e = _mm_sub_ps(e, _mm_and_ps(small, one));
+    // small ? m + m - 1 : m - 1, and m + 0 - 1 rounds exactly like m - 1.
+    const __m128 x = _mm_sub_ps(_mm_add_ps(m, _mm_and_ps(small, m)), one);
+    const __m128 z = _mm_mul_ps(x, x);
+    __m128 p = _mm_set1_ps(kLogP[0]);
+    for (int i = 1; i < kLogTerms; ++i) {
+        p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(kLogP[i]));
+    }
+    __m128 y = _mm_mul_ps(_mm_mul_ps(x, z), p);
+    y = _mm_add_ps(y, _mm_mul_ps(_mm_set1_ps(kLn2Lo), e));
+    y = _mm_add_ps(y, _mm_mul_ps(_mm_set1_ps(-0.5f), z));
+    return _mm_mul_ps(_mm_add_ps(_mm_add_ps(x, y), _mm_mul_ps(_mm_set1_ps(kLn2Hi), e)), _mm_set1_ps(kLnToDb));
+}
+
+void toDecibelsSse2(const float* data, int count, float* out)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(out + i, decibelsSse2(_mm_loadu_ps(data + i)));
+    }
+    toDecibelsScalar(data + i, count - i, out + i);
+}
+
+void colourMapSse2(const float* db, int count, float floorDb, float scale, const QRgb* lut, QRgb* out)
+{
+    const __m128 offset = _mm_set1_ps(floorDb);
+    const __m128 factor = _mm_set1_ps(scale);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 top = _mm_set1_ps(kLutTop);
+    alignas(16) qint32 index[4];
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 level = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(db + i), offset), factor);
+        level = _mm_min_ps(_mm_max_ps(level, zero), top);
+        _mm_store_si128(reinterpret_cast<__m128i*>(index), _mm_cvttps_epi32(level));
+        // SSE2 has no gather; the lookups are plain loads from a 1 KiB, cache-resident table.
+        out[i] = lut[index[0]];
+        out[i + 1] = lut[index[1]];
+        out[i + 2] = lut[index[2]];
+        out[i + 3] = lut[index[3]];
+    }
+    colourMapScalar(db + i, count - i, floorDb, scale, lut, out + i);
+}
+
+void toScreenSse2(const float* levels, int count, int pointsPerX, double left, double dx, double bottom,
+                  double height, QPointF* out)
+{
+    double* xy = reinterpret_cast<double*>(out);
+    const __m128d base = _mm_set1_pd(bottom);
+    const __m128d extent = _mm_set1_pd(height);
+    int i = 0;
+    // Two points per iteration: convert two levels to double, then interleave with x.
+    for (; i + 2 <= count; i += 2) {
+        const __m128 pair = _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(levels + i)));
+        const __m128d y = _mm_sub_pd(base, _mm_mul_pd(_mm_cvtps_pd(pair), extent));
+        __m128d x;
+        if (pointsPerX == 1) {
+            x = _mm_add_pd(_mm_set1_pd(left), _mm_mul_pd(_mm_set1_pd(dx), _mm_set_pd(i + 1.0, i)));
+        } else {
+            x = _mm_set1_pd(left + dx * (i / pointsPerX));
+        }
+        _mm_storeu_pd(xy + 2 * i, _mm_unpacklo_pd(x, y));
+        _mm_storeu_pd(xy + 2 * i + 2, _mm_unpackhi_pd(x, y));
+    }
+    for (; i < count; ++i) {
+        out[i] = QPointF(left + dx * (i / pointsPerX), bottom - levels[i] * height);
+    }
+}
+
+GMTI_TARGET_AVX2 float maxAvx2(const float* data, int count)
+{
+    if (count < 16) {
+        return maxSse2(data, count);
+    }
+    __m256 peak = _mm256_set1_ps(-kInf);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        peak = _mm256_max_ps(_mm256_loadu_ps(data + i), peak);
+    }
+    float result = horizontalMax(_mm_max_ps(_mm256_castps256_ps128(peak), _mm256_extractf128_ps(peak, 1)));
+    for (; i < count; ++i) {
+        result = data[i] > result ? data[i] : result;
+    }
+    return result;
+}
+
+GMTI_TARGET_AVX2 void columnMaxAvx2(const float* data, int samples, int columns, float* out)
+{
+    for (int column = 0; column < columns; ++column) {
+        const Span span = columnSpan(column, samples, columns);
+        out[column] = maxAvx2(data + span.begin, span.end - span.begin);
+    }
+}
+
+GMTI_TARGET_AVX2 void scaleAvx2(const float* data, int count, float scale, float* out)
+{
+    const __m256 factor = _mm256_set1_ps(scale);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), factor));
+    }
+    scaleSse2(data + i, count - i, scale, out + i);
+}
+
+GMTI_TARGET_AVX2 __m256 decibelsAvx2(__m256 value)
+{
+    value = _mm256_max_ps(value, _mm256_set1_ps(kPowerFloor));
+    const __m256i bits = _mm256_castps_si256(value);
+    __m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+    const __m256 m = _mm256_castsi256_ps(
+        _mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)), _mm256_set1_epi32(0x3f000000)));
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 small = _mm256_cmp_ps(m, _mm256_set1_ps(kSqrtHalf), _CMP_LT_OQ);
+    e = _mm256_sub_ps(e, _mm256_and_ps(small, one));
+    const __m256 x = _mm256_sub_ps(_mm256_add_ps(m, _mm256_and_ps(small, m)), one);
+    const __m256 z = _mm256_mul_ps(x, x);
+    // Separate multiply and add rather than FMA, so results match the SSE2 and scalar paths.
+    __m256 p = _mm256_set1_ps(kLogP[0]);
+    for (int i = 1; i < kLogTerms; ++i) {
+        p = _mm256_add_ps(_mm256_mul_ps(p, x), _mm256_set1_ps(kLogP[i]));
+    }
+    __m256 y = _mm256_mul_ps(_mm256_mul_ps(x, z), p);
+    y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_set1_ps(kLn2Lo), e));
+    y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_set1_ps(-0.5f), z));
+    return _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(x, y), _mm256_mul_ps(_mm256_set1_ps(kLn2Hi), e)),
+                         _mm256_set1_ps(kLnToDb));
+}
+
+GMTI_TARGET_AVX2 void toDecibelsAvx2(const float* data, int count, float* out)
+{
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(out + i, decibelsAvx2(_mm256_loadu_ps(data + i)));
+    }
+    toDecibelsSse2(data + i, count - i, out + i);
+}
+
+GMTI_TARGET_AVX2 void colourMapAvx2(const float* db, int count, float floorDb, float scale, const QRgb* lut,
+                                    QRgb* out)
+{
+    const __m256 offset = _mm256_set1_ps(floorDb);
+    const __m256 factor = _mm256_set1_ps(scale);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 top = _mm256_set1_ps(kLutTop);
+    const int* table = reinterpret_cast<const int*>(lut);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 level = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(db + i), offset), factor);
+        level = _mm256_min_ps(_mm256_max_ps(level, zero), top);
+        const __m256i colours = _mm256_i32gather_epi32(table, _mm256_cvttps_epi32(level), 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), colours);
+    }
+    colourMapSse2(db + i, count - i, floorDb, scale, lut, out + i);
+}
+
+bool cpuHasAvx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osSavesAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(info, 7, 0);
+    return osSavesAvx && (info[1] & (1 << 5));
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // GMTI_KERNELS_X86
+
+// --- NEON --------------------------------------------------------------------------------
+#ifdef GMTI_KERNELS_NEON
+
+// vmaxnm/vminnm return the number when one operand is NaN, like the scalar comparisons.
+// The lanes never hold NaN, so the across-vector reductions see only numbers.
+float maxNeon(const float* data, int count)
+{
+    if (count < 8) {
+        return maxScalar(data, count);
+    }
+    float32x4_t peak = vdupq_n_f32(-kInf);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        peak = vmaxnmq_f32(peak, vld1q_f32(data + i));
+    }
+    float result = vmaxnmvq_f32(peak);
+    for (; i < count; ++i) {
+        result = data[i] > result ? data[i] : result;
+    }
+    return result;
+}
+
+void spanMinMaxNeon(const float* data, int count, float& low, float& high)
+{
+    if (count < 8) {
+        spanMinMaxScalar(data, count, low, high);
+        return;
+    }
+    float32x4_t lows = vdupq_n_f32(kInf);
+    float32x4_t highs = vdupq_n_f32(-kInf);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const float32x4_t v = vld1q_f32(data + i);
+        lows = vminnmq_f32(lows, v);
+        highs = vmaxnmq_f32(highs, v);
+    }
+    low = vminnmvq_f32(lows);
+    high = vmaxnmvq_f32(highs);
+    for (; i < count; ++i) {
+        low = data[i] < low ? data[i] : low;
+        high = data[i] > high ? data[i] : high;
+    }
+}
+
+void columnMinMaxNeon(const float* data, int samples, int columns, float scale, float* levels)
+{
+    for (int column = 0; column < columns; ++column) {
+        const Span span = columnSpan(column, samples, columns);
+        float low;
+        float high;
+        spanMinMaxNeon(data + span.begin, span.end - span.begin, low, high);
+        levels[2 * column] = low * scale;
+        levels[2 * column + 1] = high * scale;
+    }
+}
+
+void columnMaxNeon(const float* data, int samples, int columns, float* out)
+{
+    for (int column = 0; column < columns; ++column) {
+        const Span span = columnSpan(column, samples, columns);
+        out[column] = maxNeon(data + span.begin, span.end - span.begin);
+    }
+}
+
+void scaleNeon(const float* data, int count, float scale, float* out)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(out + i, vmulq_n_f32(vld1q_f32(data + i), scale));
+    }
+    scaleScalar(data + i, count - i, scale, out + i);
+}
+
+float32x4_t decibelsNeon(float32x4_t value)
+{
+    value = vmaxnmq_f32(value, vdupq_n_f32(kPowerFloor));
+    const uint32x4_t bits = vreinterpretq_u32_f32(value);
+    float32x4_t e =
+        vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(126)));
+    const float32x4_t m =
+        vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007fffffu)), vdupq_n_u32(0x3f000000u)));
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const uint32x4_t small = vcltq_f32(m, vdupq_n_f32(kSqrtHalf));
+    e = vsubq_f32(e, vreinterpretq_f32_u32(vandq_u32(small, vreinterpretq_u32_f32(one))));
+    const float32x4_t x =
+        vsubq_f32(vaddq_f32(m, vreinterpretq_f32_u32(vandq_u32(small, vreinterpretq_u32_f32(m)))), one);
+    const float32x4_t z = vmulq_f32(x, x);
+    // vmulq + vaddq rather than vfmaq, so results match the scalar path.
+    float32x4_t p = vdupq_n_f32(kLogP[0]);
+    for (int i = 1; i < kLogTerms; ++i) {
+        p = vaddq_f32(vmulq_f32(p, x), vdupq_n_f32(kLogP[i]));
+    }
+    float32x4_t y = vmulq_f32(vmulq_f32(x, z), p);
+    y = vaddq_f32(y, vmulq_n_f32(e, kLn2Lo));
+    y = vaddq_f32(y, vmulq_n_f32(z, -0.5f));
+    return vmulq_n_f32(vaddq_f32(vaddq_f32(x, y), vmulq_n_f32(e, kLn2Hi)), kLnToDb);
+}
+
+void toDecibelsNeon(const float* data, int count, float* out)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(out + i, decibelsNeon(vld1q_f32(data + i)));
+    }
+    toDecibelsScalar(data + i, count - i, out + i);
+}
+
+void colourMapNeon(const float* db, int count, float floorDb, float scale, const QRgb* lut, QRgb* out)
+{
+    const float32x4_t offset = vdupq_n_f32(floorDb);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t top = vdupq_n_f32(kLutTop);
+    int32_t index[4];
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t level = vmulq_n_f32(vsubq_f32(vld1q_f32(db + i), offset), scale);
+        level = vminnmq_f32(vmaxnmq_f32(level, zero), top);
+        vst1q_s32(index, vcvtq_s32_f32(level));
+        out[i] = lut[index[0]];
+        out[i + 1] = lut[index[1]];
+        out[i + 2] = lut[index[2]];
+        out[i + 3] = lut[index[3]];
+    }
+    colourMapScalar(db + i, count - i, floorDb, scale, lut, out + i);
+}
+
+void toScreenNeon(const float* levels, int count, int pointsPerX, double left, double dx, double bottom,
+                  double height, QPointF* out)
+{
+    double* xy = reinterpret_cast<double*>(out);
+    const float64x2_t base = vdupq_n_f64(bottom);
+    const float64x2_t extent = vdupq_n_f64(height);
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const float64x2_t y = vsubq_f64(base, vmulq_f64(vcvt_f64_f32(vld1_f32(levels + i)), extent));
+        float64x2_t x;
+        if (pointsPerX == 1) {
+            const double index[2] = {double(i), i + 1.0};
+            x = vaddq_f64(vdupq_n_f64(left), vmulq_f64(vdupq_n_f64(dx), vld1q_f64(index)));
+        } else {
+            x = vdupq_n_f64(left + dx * (i / pointsPerX));
+        }
+        vst1q_f64(xy + 2 * i, vzip1q_f64(x, y));
+        vst1q_f64(xy + 2 * i + 2, vzip2q_f64(x, y));
+    }
+    for (; i < count; ++i) {
+        out[i] = QPointF(left + dx * (i / pointsPerX), bottom - levels[i] * height);
+    }
+}
+
+#endif // GMTI_KERNELS_NEON
+
+// --- Dispatch ----------------------------------------------------------------------------
+
+struct KernelSet
+{
+    const char* name;
+    float (*max_value)(const float*, int);
+    void (*column_min_max)(const float*, int, int, float, float*);
+    void (*column_max)(const float*, int, int, float*);
+    void (*scale)(const float*, int, float, float*);
+    void (*to_decibels)(const float*, int, float*);
+    void (*colour_map)(const float*, int, float, float, const QRgb*, QRgb*);
+    void (*to_screen)(const float*, int, int, double, double, double, double, QPointF*);
+};
+
+constexpr KernelSet kScalar{"scalar",        maxScalar,        columnMinMaxScalar, columnMaxScalar,
+                            scaleScalar,     toDecibelsScalar, colourMapScalar,    toScreenScalar};
+#ifdef GMTI_KERNELS_X86
+constexpr KernelSet kSse2{"sse2",   maxSse2,        columnMinMaxSse2, columnMaxSse2,
+                          scaleSse2, toDecibelsSse2, colourMapSse2,    toScreenSse2};
+// Min/max spans are a few bins at screen widths and to_screen is bound by its interleaved
+// double stores, so AVX2 keeps the SSE2 versions of both.
+constexpr KernelSet kAvx2{"avx2",   maxAvx2,        columnMinMaxSse2, columnMaxAvx2,
+                          scaleAvx2, toDecibelsAvx2, colourMapAvx2,    toScreenSse2};
+#endif
+#ifdef GMTI_KERNELS_NEON
+constexpr KernelSet kNeon{"neon",   maxNeon,        columnMinMaxNeon, columnMaxNeon,
+                          scaleNeon, toDecibelsNeon, colourMapNeon,    toScreenNeon};
+#endif
+
+KernelSet selectKernels()
+{
+    // Supported sets, widest first.
+    const KernelSet* supported[3] = {};
+    int count = 0;
+#ifdef GMTI_KERNELS_X86
+    if (cpuHasAvx2()) {
+        supported[count++] = &kAvx2;
+    }
+    supported[count++] = &kSse2;
+#endif
+#ifdef GMTI_KERNELS_NEON
+    supported[count++] = &kNeon;
+#endif
+    supported[count++] = &kScalar;
+
+    const QByteArray forced = qgetenv("GMTI_SIMD").trimmed().toLower();
+    if (forced.isEmpty()) {
+        return *supported[0];
+    }
+    for (int i = 0; i < count; ++i) {
+        if (forced == supported[i]->name) {
+            return *supported[i];
+        }
+    }
+    qWarning("GMTI_SIMD=%s is not supported on this CPU; using %s", forced.constData(), supported[0]->name);
+    return *supported[0];
+}
+
+const KernelSet& kernels()
+{
+    static const KernelSet selected = selectKernels();
+    return selected;
+}
+} // namespace
+
+namespace ProfileKernels
+{
+const char* isa()
+{
+    return kernels().name;
+}
+
+float maxValue(const float* data, int count)
+{
+    return kernels().max_value(data, count);
+}
+
+void columnMinMax(const float* data, int samples, int columns, float scale, float* levels)
+{
+    kernels().column_min_max(data, samples, columns, scale, levels);
+}
+
+void columnMax(const float* data, int samples, int columns, float* out)
+{
+    kernels().column_max(data, samples, columns, out);
+}
+
+void scale(const float* data, int count, float scale, float* out)
+{
+    kernels().scale(data, count, scale, out);
+}
+
+void toDecibels(const float* data, int count, float* out)
+{
+    kernels().to_decibels(data, count, out);
+}
+
+void colourMap(const float* db, int count, float floorDb, float scale, const QRgb* lut, QRgb* out)
+{
+    kernels().colour_map(db, count, floorDb, scale, lut, out);
+}
+
+void toScreen(const float* levels, int count, int pointsPerX, double left, double dx, double bottom,
+              double height, QPointF* out)
+{
+    kernels().to_screen(levels, count, pointsPerX, left, dx, bottom, height, out);
+}
+} // namespace ProfileKernels
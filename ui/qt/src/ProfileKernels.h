@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QPointF>
+#include <QRgb>
+
+// Vectorised loops over float profiles, shared by the graph widgets: peak search, per-column
+// decimation, normalisation, dB conversion, palette lookup and conversion to screen points.
+// Each kernel has SSE2 and AVX2 (x86-64) or NEON (AArch64) versions next to a scalar one;
+// the widest set the CPU supports is picked on first use. GMTI_SIMD=scalar|sse2|avx2|neon
+// forces a narrower set, e.g. to compare them in the bench. Every set computes dB with the
+// same logarithm approximation, so widgets look identical whichever one runs.
+namespace ProfileKernels
+{
+// Instruction set in use: "avx2", "sse2", "neon" or "scalar".
+const char* isa();
+
+// Largest value, or 0 for an empty array. Every min/max kernel skips NaN samples; a span
+// holding nothing but NaNs has a maximum of -infinity and a minimum of +infinity.
+float maxValue(const float* data, int count);
+
+// Splits `samples` values into `columns` contiguous spans (at least one sample each, so
+// columns <= samples) and writes each span's minimum and maximum times `scale` as a
+// low/high pair: `levels` receives 2 * columns floats.
+void columnMinMax(const float* data, int samples, int columns, float scale, float* levels);
+// Same spans, keeping only each maximum: `out` receives `columns` floats.
+void columnMax(const float* data, int samples, int columns, float* out);
+
+// out[i] = data[i] * scale; `out` may alias `data`.
+void scale(const float* data, int count, float scale, float* out);
+
+// out[i] = 10 log10(max(data[i], 1e-12)), within 1e-5 dB of std::log10; `out` may alias `data`.
+void toDecibels(const float* data, int count, float* out);
+
+// out[i] = lut[clamp(int((db[i] - floorDb) * scale), 0, 255)]; `lut` has 256 entries.
+void colourMap(const float* db, int count, float floorDb, float scale, const QRgb* lut, QRgb* out);
+
+// Screen points for normalised levels: point i sits at x = left + dx * (i / pointsPerX) and
+// y = bottom - levels[i] * height. pointsPerX is 1 for one point per sample or 2 for the
+// low/high pairs written by columnMinMax, which share an x.
+void toScreen(const float* levels, int count, int pointsPerX, double left, double dx, double bottom,
+              double height, QPointF* out);
+} // namespace ProfileKernels
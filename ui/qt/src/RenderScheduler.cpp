@@ -0,0 +1,74 @@
+#include "RenderScheduler.h"
+
+#include "Diagnostics.h"
+
+#include <QGuiApplication>
+#include <QScreen>
+#include <QWidget>
+#include <QtMath>
+#include <utility>
+
+namespace
+{
+constexpr qreal kFallbackRefreshHz = 60.0;
+constexpr int kIdleTicksBeforeStop = 2;
+
+int frameIntervalMs()
+{
+    const QScreen* screen = QGuiApplication::primaryScreen();
+    const qreal hz = screen && screen->refreshRate() > 1.0 ? screen->refreshRate() : kFallbackRefreshHz;
+    return qMax(1, qFloor(1000.0 / hz));
+}
+} // namespace
+
+RenderScheduler& RenderScheduler::instance()
+{
+    static RenderScheduler scheduler;
+    return scheduler;
+}
+
+RenderScheduler::RenderScheduler()
+{
+    timer_.setTimerType(Qt::PreciseTimer);
+    connect(&timer_, &QTimer::timeout, this, &RenderScheduler::onTick);
+    // The scheduler is a function static and outlives the event loop.
+    if (QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, &timer_, &QTimer::stop);
+    }
+}
+
+void RenderScheduler::requestUpdate(QWidget* widget)
+{
+    if (pending_.contains(widget)) {
+        Diagnostics::instance().addCoalescedRepaint();
+        return;
+    }
+    pending_.append(widget);
+    if (!timer_.isActive()) {
+        // Re-read on every start so moving to a faster or slower display takes effect.
+        timer_.start(frameIntervalMs());
+        idle_ticks_ = 0;
+    }
+}
+
+void RenderScheduler::flush()
+{
+    const QVector<QPointer<QWidget>> pending = std::exchange(pending_, {});
+    for (const QPointer<QWidget>& widget : pending) {
+        if (widget) {
+            widget->update();
+        }
+    }
+}
+
+void RenderScheduler::onTick()
+{
+    if (pending_.isEmpty()) {
+        if (++idle_ticks_ >= kIdleTicksBeforeStop) {
+            timer_.stop();
+        }
+        return;
+    }
+    idle_ticks_ = 0;
+    flush();
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QVector>
+
+class QWidget;
+
+// Coalesces data-driven repaints to at most one per display refresh. Widgets keep only
+// their newest snapshot and call requestUpdate() instead of update(); every request
+// that lands while the widget is still waiting for its tick is folded into that repaint
+// and counted as a coalesced repaint. The tick timer only runs while work is queued.
+class RenderScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    static RenderScheduler& instance();
+
+    void requestUpdate(QWidget* widget);
+    // Repaints everything queued now instead of on the next tick.
+    void flush();
+    int intervalMs() const { return timer_.interval(); }
+
+private:
+    RenderScheduler();
+    void onTick();
+
+    QTimer timer_;
+    QVector<QPointer<QWidget>> pending_;
+    // Consecutive ticks with nothing queued; the timer stops after a couple.
+    int idle_ticks_ = 0;
+};
@@ -0,0 +1,155 @@
+#include "ScenarioCatalog.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+#include <QStringList>
+
+#include <utility>
+
+namespace
+{
+constexpr int kRescanDelayMs = 250;
+} // namespace
+
+ScenarioCatalog::ScenarioCatalog(QObject* parent)
+    : QObject(parent)
+    , scanner_(new QObject)
+{
+    scan_thread_.setObjectName(QStringLiteral("gmti-scenario-scan"));
+    scanner_->moveToThread(&scan_thread_);
+    connect(&scan_thread_, &QThread::finished, scanner_, &QObject::deleteLater);
+    scan_thread_.start();
+
+    rescan_timer_.setSingleShot(true);
+    rescan_timer_.setInterval(kRescanDelayMs);
+    connect(&rescan_timer_, &QTimer::timeout, this, &ScenarioCatalog::rescan);
+    connect(&watcher_, &QFileSystemWatcher::directoryChanged, this, &ScenarioCatalog::scheduleRescan);
+    connect(&watcher_, &QFileSystemWatcher::fileChanged, this, &ScenarioCatalog::scheduleRescan);
+}
+
+ScenarioCatalog::~ScenarioCatalog()
+{
+    scan_thread_.quit();
+    scan_thread_.wait();
+}
+
+void ScenarioCatalog::setDirectory(const QString& path)
+{
+    const QString directory = QDir(path).absolutePath();
+    if (!watcher_.directories().isEmpty()) {
+        watcher_.removePaths(watcher_.directories());
+    }
+    if (!watcher_.files().isEmpty()) {
+        watcher_.removePaths(watcher_.files());
+    }
+    directory_ = directory;
+    entries_.clear();
+    index_.clear();
+    emit entriesChanged();
+    rescan();
+}
+
+const ScenarioCatalog::Entry* ScenarioCatalog::find(const QString& path) const
+{
+    const auto it = index_.constFind(path);
+    return it == index_.cend() ? nullptr : &entries_[it.value()];
+}
+
+void ScenarioCatalog::scheduleRescan()
+{
+    rescan_timer_.start();
+}
+
+void ScenarioCatalog::rescan()
+{
+    rescan_timer_.stop();
+    const quint64 generation = ++generation_;
+    const QString directory = directory_;
+    QMetaObject::invokeMethod(
+        scanner_,
+        [this, generation, directory]() {
+            const QDir dir(directory);
+            if (!dir.exists()) {
+                QMetaObject::invokeMethod(
+                    this, [this, generation, directory]() { applyScan(generation, directory, false, {}); },
+                    Qt::QueuedConnection);
+                return;
+            }
+
+            QVector<Entry> entries;
+            QHash<QString, Entry> fresh;
+            const auto files = dir.entryInfoList(QStringList{QStringLiteral("*.yaml")}, QDir::Files, QDir::Name);
+            entries.reserve(files.size());
+            for (const QFileInfo& file : files) {
+                const QString path = file.absoluteFilePath();
+                const QDateTime modified = file.lastModified();
+                const auto cached = cache_.constFind(path);
+                if (cached != cache_.cend() && cached->modified == modified && cached->size == file.size()) {
+                    entries.append(cached.value());
+                } else {
+                    QFile handle(path);
+                    if (!handle.open(QIODevice::ReadOnly)) {
+                        continue;
+                    }
+                    const QByteArray contents = handle.readAll();
+                    if (contents.isEmpty()) {
+                        continue;
+                    }
+                    Entry entry;
+                    entry.path = path;
+                    entry.file_name = file.fileName();
+                    entry.modified = modified;
+                    entry.size = file.size();
+                    entry.parsed = ScenarioFile::parse(contents);
+                    entry.parsed.values.path = path;
+                    entries.append(entry);
+                }
+                fresh.insert(path, entries.last());
+            }
+            // Only the listed directory is kept; other directories re-parse when revisited.
+            cache_ = std::move(fresh);
+            QMetaObject::invokeMethod(
+                this,
+                [this, generation, directory, entries]() { applyScan(generation, directory, true, entries); },
+                Qt::QueuedConnection);
+        },
+        Qt::QueuedConnection);
+}
+
+void ScenarioCatalog::applyScan(quint64 generation, const QString& directory, bool exists,
+                                const QVector<Entry>& entries)
+{
+    if (generation != generation_ || directory != directory_) {
+        return;
+    }
+    if (!exists) {
+        emit directoryMissing(directory);
+        return;
+    }
+
+    entries_ = entries;
+    index_.clear();
+    index_.reserve(entries_.size());
+    QStringList files;
+    files.reserve(entries_.size());
+    for (int i = 0; i < entries_.size(); ++i) {
+        index_.insert(entries_[i].path, i);
+        files.append(entries_[i].path);
+    }
+
+    if (watcher_.directories().isEmpty()) {
+        watcher_.addPath(directory);
+    }
+    const QStringList watched = watcher_.files();
+    if (QSet<QString>(watched.cbegin(), watched.cend()) != QSet<QString>(files.cbegin(), files.cend())) {
+        if (!watched.isEmpty()) {
+            watcher_.removePaths(watched);
+        }
+        if (!files.isEmpty()) {
+            watcher_.addPaths(files);
+        }
+    }
+    emit entriesChanged();
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ScenarioFile.h"
+
+#include <QDateTime>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+#include <QVector>
+
+// Every `*.yaml` scenario in one directory, listed and parsed on a background thread and
+// cached by path, modification time and size, so a rescan only rereads files that
+// changed. A QFileSystemWatcher triggers rescans when decks are added, removed or
+// edited. Lookups by path are O(1) on the GUI thread.
+class ScenarioCatalog : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Entry
+    {
+        QString path;
+        QString file_name;
+        QDateTime modified;
+        qint64 size = 0;
+        ScenarioFile::Parsed parsed;
+    };
+
+    explicit ScenarioCatalog(QObject* parent = nullptr);
+    ~ScenarioCatalog() override;
+
+    // Starts an asynchronous scan; entriesChanged() follows once it completes.
+    void setDirectory(const QString& path);
+    QString directory() const { return directory_; }
+    // Sorted by file name.
+    const QVector<Entry>& entries() const { return entries_; }
+    const Entry* find(const QString& path) const;
+
+signals:
+    void entriesChanged();
+    void directoryMissing(const QString& path);
+
+private:
+    void scheduleRescan();
+    void rescan();
+    void applyScan(quint64 generation, const QString& directory, bool exists, const QVector<Entry>& entries);
+
+    QString directory_;
+    QVector<Entry> entries_;
+    QHash<QString, int> index_;
+    // Bumped per requested scan so results for a directory we have left are dropped.
+    quint64 generation_ = 0;
+    QFileSystemWatcher watcher_;
+    // Editors save in bursts (write, rename, chmod); one rescan covers the lot.
+    QTimer rescan_timer_;
+    QThread scan_thread_;
+    // Lives on scan_thread_, as does cache_.
+    QObject* scanner_;
+    QHash<QString, Entry> cache_;
+};
@@ -0,0 +1,209 @@
+#include "ScenarioFile.h"
+
+#include <QFile>
+#include <QFileInfo>
+
+#include <cstring>
+
+namespace
+{
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+bool isBlank(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+// Leading `\d+` of `value`, or `[+-]?\d+(\.\d+)?` when `real`; empty when it has none.
+QByteArray numericPrefix(const QByteArray& value, bool real)
+{
+    const int n = value.size();
+    int i = 0;
+    if (real && i < n && (value[i] == '+' || value[i] == '-')) {
+        ++i;
+    }
+    const int digits = i;
+    while (i < n && isDigit(value[i])) {
+        ++i;
+    }
+    if (i == digits) {
+        return {};
+    }
+    if (real && i + 1 < n && value[i] == '.' && isDigit(value[i + 1])) {
+        i += 2;
+        while (i < n && isDigit(value[i])) {
+            ++i;
+        }
+    }
+    return value.left(i);
+}
+
+unsigned keyOf(const QByteArray& name)
+{
+    using namespace ScenarioFile;
+    switch (name.size()) {
+    case 4:
+        return name == "taps" ? Taps : name == "seed" ? Seed : 0u;
+    case 5:
+        return name == "noise" ? Noise : 0u;
+    case 9:
+        return name == "frequency" ? Frequency : 0u;
+    case 10:
+        return name == "range_bins" ? RangeBins : 0u;
+    case 11:
+        return name == "description" ? Description : 0u;
+    case 12:
+        return name == "doppler_bins" ? DopplerBins : 0u;
+    default:
+        return 0u;
+    }
+}
+} // namespace
+
+QString Scenario::name() const
+{
+    return QFileInfo(path).baseName();
+}
+
+QJsonObject Scenario::toGeneratorConfig(quint64 resolved_seed) const
+{
+    QJsonObject payload;
+    payload.insert(QStringLiteral("taps"), taps);
+    payload.insert(QStringLiteral("range_bins"), range_bins);
+    payload.insert(QStringLiteral("doppler_bins"), doppler_bins);
+    payload.insert(QStringLiteral("frequency"), frequency);
+    payload.insert(QStringLiteral("noise"), noise);
+    payload.insert(QStringLiteral("seed"), static_cast<qint64>(resolved_seed));
+    if (!path.isEmpty()) {
+        payload.insert(QStringLiteral("scenario"), name());
+    }
+    if (!description.isEmpty()) {
+        payload.insert(QStringLiteral("description"), description);
+    }
+    return payload;
+}
+
+namespace ScenarioFile
+{
+Scenario Parsed::applyTo(const Scenario& defaults) const
+{
+    Scenario scenario = defaults;
+    scenario.path = values.path;
+    if (keys & Taps) {
+        scenario.taps = values.taps;
+    }
+    if (keys & RangeBins) {
+        scenario.range_bins = values.range_bins;
+    }
+    if (keys & DopplerBins) {
+        scenario.doppler_bins = values.doppler_bins;
+    }
+    if (keys & Frequency) {
+        scenario.frequency = values.frequency;
+    }
+    if (keys & Noise) {
+        scenario.noise = values.noise;
+    }
+    scenario.seed = (keys & Seed) ? values.seed : 0;
+    scenario.description = (keys & Description) ? values.description : QString();
+    return scenario;
+}
+
+Parsed parse(const QByteArray& contents)
+{
+    Parsed parsed;
+    const char* cursor = contents.constData();
+    const char* const end = cursor + contents.size();
+    while (cursor < end) {
+        const char* eol = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+        if (!eol) {
+            eol = end;
+        }
+        const char* line = cursor;
+        cursor = eol + 1;
+
+        const char* colon = static_cast<const char*>(std::memchr(line, ':', eol - line));
+        if (!colon) {
+            continue;
+        }
+        const unsigned key = keyOf(QByteArray::fromRawData(line, static_cast<int>(colon - line)));
+        if (key == 0 || (parsed.keys & key)) {
+            continue;
+        }
+        const char* valueBegin = colon + 1;
+        while (valueBegin < eol && isBlank(*valueBegin)) {
+            ++valueBegin;
+        }
+        const char* valueEnd = eol;
+        if (valueEnd > valueBegin && valueEnd[-1] == '\r') {
+            --valueEnd;
+        }
+        const QByteArray value = QByteArray::fromRawData(valueBegin, static_cast<int>(valueEnd - valueBegin));
+
+        Scenario& v = parsed.values;
+        switch (key) {
+        case Taps:
+        case RangeBins:
+        case DopplerBins: {
+            const QByteArray digits = numericPrefix(value, false);
+            if (digits.isEmpty()) {
+                continue;
+            }
+            const int number = digits.toInt();
+            (key == Taps ? v.taps : key == RangeBins ? v.range_bins : v.doppler_bins) = number;
+            break;
+        }
+        case Frequency:
+        case Noise: {
+            const QByteArray number = numericPrefix(value, true);
+            if (number.isEmpty()) {
+                continue;
+            }
+            (key == Frequency ? v.frequency : v.noise) = number.toDouble();
+            break;
+        }
+        case Seed: {
+            const QByteArray digits = numericPrefix(value, false);
+            if (digits.isEmpty()) {
+                continue;
+            }
+            v.seed = digits.toULongLong();
+            break;
+        }
+        case Description: {
+            QString text = QString::fromUtf8(value).trimmed();
+            if (text.isEmpty()) {
+                continue;
+            }
+            if (text.size() >= 2 && text.startsWith(QLatin1Char('"')) && text.endsWith(QLatin1Char('"'))) {
+                text = text.mid(1, text.size() - 2);
+            }
+            v.description = text;
+            break;
+        }
+        }
+        parsed.keys |= key;
+    }
+    return parsed;
+}
+
+bool load(const QString& path, const Scenario& defaults, Scenario* scenario)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray contents = file.readAll();
+    if (contents.isEmpty()) {
+        return false;
+    }
+
+    Parsed parsed = parse(contents);
+    parsed.values.path = path;
+    *scenario = parsed.applyTo(defaults);
+    return true;
+}
+} // namespace ScenarioFile
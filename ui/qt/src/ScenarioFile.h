@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+
+// Flat `key: value` scenario YAML as found in simulator/configs, and its mapping onto the
+// bridge's GeneratorConfig JSON. Shared by the configurator and the sweep runner.
+struct Scenario
+{
+    QString path;
+    int taps = 4;
+    int range_bins = 2048;
+    int doppler_bins = 256;
+    double frequency = 32.0;
+    double noise = 0.03;
+    // 0 means "pick one when submitting".
+    quint64 seed = 0;
+    QString description;
+
+    QString name() const;
+    // Body for POST /ingest-config; `seed` must already be resolved.
+    QJsonObject toGeneratorConfig(quint64 seed) const;
+};
+
+namespace ScenarioFile
+{
+// Keys a scenario file may set, as bits of Parsed::keys.
+enum Key : unsigned
+{
+    Taps = 1u << 0,
+    RangeBins = 1u << 1,
+    DopplerBins = 1u << 2,
+    Frequency = 1u << 3,
+    Noise = 1u << 4,
+    Seed = 1u << 5,
+    Description = 1u << 6
+};
+
+// Result of one pass over a file: `values` holds what the file set, `keys` which of them
+// it set, so one cached parse can be laid over whatever the controls currently hold.
+struct Parsed
+{
+    Scenario values;
+    unsigned keys = 0;
+
+    // `defaults` for every key the file leaves out, except that seed and description
+    // fall back to "unset" rather than carrying over from another scenario.
+    Scenario applyTo(const Scenario& defaults) const;
+};
+
+// Single forward scan of top-level `key: value` lines; the first usable value of a key wins.
+Parsed parse(const QByteArray& contents);
+// Reads `path`, keeping `defaults` for any key the file does not set. Returns false when
+// the file cannot be read or is empty.
+bool load(const QString& path, const Scenario& defaults, Scenario* scenario);
+} // namespace ScenarioFile
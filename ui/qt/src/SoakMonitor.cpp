@@ -0,0 +1,303 @@
+#include "SoakMonitor.h"
+
+#include "DetectionStore.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <cstdio>
+#include <limits>
+
+#if defined(Q_OS_LINUX)
+#include <unistd.h>
+#elif defined(Q_OS_MACOS)
+#include <mach/mach.h>
+#elif defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#endif
+
+namespace
+{
+constexpr qint64 kMinSampleMs = 1000;
+constexpr qint64 kMaxSampleMs = 60000;
+constexpr int kSamplesPerRun = 10;
+// Below this an end-to-end p99 rise is timer and bucket noise rather than a slowdown.
+constexpr qint64 kMinSlowdownUs = 1000;
+constexpr double kFpsTolerance = 0.9;
+constexpr double kMiB = 1024.0 * 1024.0;
+
+double toMiB(qint64 bytes)
+{
+    return bytes / kMiB;
+}
+
+QString formatMs(qint64 micros)
+{
+    return QString::number(micros / 1000.0, 'f', 1);
+}
+
+QJsonObject latencyJson(const LatencyHistogram::Summary& s)
+{
+    return QJsonObject{{QStringLiteral("count"), static_cast<qint64>(s.count)},
+                       {QStringLiteral("p50_us"), s.p50_us},
+                       {QStringLiteral("p90_us"), s.p90_us},
+                       {QStringLiteral("p99_us"), s.p99_us},
+                       {QStringLiteral("max_us"), s.max_us},
+                       {QStringLiteral("mean_us"), s.mean_us}};
+}
+} // namespace
+
+SoakMonitor::SoakMonitor(double minutes, const Limits& limits, const DetectionStore* history, QObject* parent)
+    : QObject(parent)
+    , duration_ms_(qMax<qint64>(kMinSampleMs, static_cast<qint64>(minutes * 60000.0)))
+    , limits_(limits)
+    , history_(history)
+{
+    sample_timer_.setInterval(static_cast<int>(qBound(kMinSampleMs, duration_ms_ / kSamplesPerRun, kMaxSampleMs)));
+    end_timer_.setSingleShot(true);
+    end_timer_.setInterval(static_cast<int>(qMin<qint64>(duration_ms_, std::numeric_limits<int>::max())));
+    connect(&sample_timer_, &QTimer::timeout, this, &SoakMonitor::takeSample);
+    connect(&end_timer_, &QTimer::timeout, this, &SoakMonitor::finish);
+}
+
+void SoakMonitor::start()
+{
+    const auto& diagnostics = Diagnostics::instance();
+    start_frames_ = last_frames_ = diagnostics.frames();
+    start_dropped_ = last_dropped_ = diagnostics.droppedFrames();
+    start_coalesced_ = diagnostics.coalescedRepaints();
+    start_end_to_end_ = last_end_to_end_ = diagnostics.snapshot(Diagnostics::Stage::EndToEnd);
+    start_paint_ = last_paint_ = diagnostics.snapshot(Diagnostics::Stage::Paint);
+    start_decode_ = diagnostics.snapshot(Diagnostics::Stage::Decode);
+    start_rss_ = peak_rss_ = residentBytes();
+    samples_.clear();
+    clock_.start();
+    sample_timer_.start();
+    end_timer_.start();
+    QTextStream(stdout) << QStringLiteral("soak: running %1 min, sampling every %2 s\n")
+                               .arg(duration_ms_ / 60000.0, 0, 'f', 1)
+                               .arg(sample_timer_.interval() / 1000);
+}
+
+qint64 SoakMonitor::residentBytes()
+{
+#if defined(Q_OS_LINUX)
+    // statm is in pages: total program size, then resident.
+    long pages = 0;
+    long resident = 0;
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (!statm) {
+        return -1;
+    }
+    const int read = std::fscanf(statm, "%ld %ld", &pages, &resident);
+    std::fclose(statm);
+    return read == 2 ? static_cast<qint64>(resident) * sysconf(_SC_PAGESIZE) : -1;
+#elif defined(Q_OS_MACOS)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) !=
+        KERN_SUCCESS) {
+        return -1;
+    }
+    return static_cast<qint64>(info.resident_size);
+#elif defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return -1;
+    }
+    return static_cast<qint64>(counters.WorkingSetSize);
+#else
+    return -1;
+#endif
+}
+
+void SoakMonitor::takeSample()
+{
+    const auto& diagnostics = Diagnostics::instance();
+    Sample sample;
+    sample.elapsed_ms = clock_.elapsed();
+    sample.rss_bytes = residentBytes();
+    sample.history_bytes = history_ ? history_->memoryUsed() : 0;
+    const quint64 frames = diagnostics.frames();
+    const quint64 dropped = diagnostics.droppedFrames();
+    const qint64 span_ms = sample.elapsed_ms - (samples_.isEmpty() ? 0 : samples_.last().elapsed_ms);
+    sample.frames = frames - last_frames_;
+    sample.dropped = dropped - last_dropped_;
+    sample.fps = span_ms > 0 ? sample.frames * 1000.0 / span_ms : 0.0;
+    const auto endToEnd = diagnostics.snapshot(Diagnostics::Stage::EndToEnd);
+    const auto paint = diagnostics.snapshot(Diagnostics::Stage::Paint);
+    sample.end_to_end = LatencyHistogram::summaryBetween(last_end_to_end_, endToEnd);
+    sample.paint = LatencyHistogram::summaryBetween(last_paint_, paint);
+    last_frames_ = frames;
+    last_dropped_ = dropped;
+    last_end_to_end_ = endToEnd;
+    last_paint_ = paint;
+    peak_rss_ = qMax(peak_rss_, sample.rss_bytes);
+    samples_.append(sample);
+
+    QTextStream(stdout) << QStringLiteral("soak: %1/%2 min | RSS %3 MiB | %4 frames/s | %5 dropped | p99 %6 ms\n")
+                               .arg(sample.elapsed_ms / 60000.0, 0, 'f', 1)
+                               .arg(duration_ms_ / 60000.0, 0, 'f', 1)
+                               .arg(toMiB(sample.rss_bytes), 0, 'f', 1)
+                               .arg(sample.fps, 0, 'f', 1)
+                               .arg(sample.dropped)
+                               .arg(formatMs(sample.end_to_end.p99_us));
+}
+
+void SoakMonitor::finish()
+{
+    sample_timer_.stop();
+    // The last interval is usually shorter than the others; it still counts.
+    if (samples_.isEmpty() || clock_.elapsed() - samples_.last().elapsed_ms >= kMinSampleMs) {
+        takeSample();
+    }
+
+    QStringList failures;
+    const quint64 frames = Diagnostics::instance().frames() - start_frames_;
+    if (frames == 0) {
+        failures.append(QStringLiteral("no frames arrived"));
+    }
+    // samples_[0] is warm-up; memory is measured from its end and frame times compared from
+    // the next interval on. Short runs with a single sample compare it with itself.
+    const Sample& last = samples_.last();
+    const Sample& reference = samples_.size() > 2 ? samples_[1] : samples_.first();
+    const double growth = growthMb();
+    if (growth > limits_.max_rss_growth_mb) {
+        failures.append(QStringLiteral("memory grew %1 MiB after warm-up (limit %2)")
+                            .arg(growth, 0, 'f', 1)
+                            .arg(limits_.max_rss_growth_mb, 0, 'f', 0));
+    }
+    if (reference.end_to_end.count > 0 && last.end_to_end.count > 0 &&
+        last.end_to_end.p99_us > reference.end_to_end.p99_us * limits_.max_p99_ratio &&
+        last.end_to_end.p99_us - reference.end_to_end.p99_us > kMinSlowdownUs) {
+        failures.append(QStringLiteral("end-to-end p99 rose from %1 to %2 ms")
+                            .arg(formatMs(reference.end_to_end.p99_us), formatMs(last.end_to_end.p99_us)));
+    }
+    if (limits_.target_fps > 0.0) {
+        for (int i = 1; i < samples_.size(); ++i) {
+            if (samples_[i].fps < limits_.target_fps * kFpsTolerance) {
+                failures.append(QStringLiteral("%1 frames/s at %2 min (target %3)")
+                                    .arg(samples_[i].fps, 0, 'f', 1)
+                                    .arg(samples_[i].elapsed_ms / 60000.0, 0, 'f', 1)
+                                    .arg(limits_.target_fps, 0, 'f', 1));
+                break;
+            }
+        }
+    }
+
+    const QJsonObject summary = report(failures);
+    const QJsonObject memory = summary.value(QStringLiteral("memory")).toObject();
+    const QJsonObject frameTimes = summary.value(QStringLiteral("end_to_end")).toObject();
+    QTextStream out(stdout);
+    out << QStringLiteral("soak: %1 frames in %2 min (%3/s), %4 dropped, %5 repaints coalesced\n")
+               .arg(frames)
+               .arg(clock_.elapsed() / 60000.0, 0, 'f', 1)
+               .arg(summary.value(QStringLiteral("fps")).toDouble(), 0, 'f', 1)
+               .arg(summary.value(QStringLiteral("dropped_frames")).toInteger())
+               .arg(summary.value(QStringLiteral("coalesced_repaints")).toInteger());
+    out << QStringLiteral("soak: RSS %1 -> %2 MiB (peak %3), %4 MiB growth after warm-up excluding "
+                          "detection history (%5 MiB/h)\n")
+               .arg(memory.value(QStringLiteral("start_mb")).toDouble(), 0, 'f', 1)
+               .arg(memory.value(QStringLiteral("end_mb")).toDouble(), 0, 'f', 1)
+               .arg(memory.value(QStringLiteral("peak_mb")).toDouble(), 0, 'f', 1)
+               .arg(memory.value(QStringLiteral("growth_mb")).toDouble(), 0, 'f', 1)
+               .arg(memory.value(QStringLiteral("growth_mb_per_hour")).toDouble(), 0, 'f', 2);
+    out << QStringLiteral("soak: end-to-end p50 %1 ms, p90 %2 ms, p99 %3 ms, max %4 ms\n")
+               .arg(formatMs(frameTimes.value(QStringLiteral("p50_us")).toInteger()),
+                    formatMs(frameTimes.value(QStringLiteral("p90_us")).toInteger()),
+                    formatMs(frameTimes.value(QStringLiteral("p99_us")).toInteger()),
+                    formatMs(frameTimes.value(QStringLiteral("max_us")).toInteger()));
+    out << (failures.isEmpty() ? QStringLiteral("soak: PASS\n")
+                               : QStringLiteral("soak: FAIL: %1\n").arg(failures.join(QStringLiteral("; "))));
+    out.flush();
+
+    if (!report_path_.isEmpty()) {
+        QFile file(report_path_);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+            file.write(QJsonDocument(summary).toJson()) < 0) {
+            qWarning("Cannot write soak report to %s", qPrintable(report_path_));
+        }
+    }
+    emit finished(failures.isEmpty());
+}
+
+double SoakMonitor::growthMb() const
+{
+    const Sample& warm = samples_.first();
+    const Sample& last = samples_.last();
+    if (warm.rss_bytes < 0 || last.rss_bytes < 0) {
+        return 0.0;
+    }
+    return toMiB((last.rss_bytes - last.history_bytes) - (warm.rss_bytes - warm.history_bytes));
+}
+
+QJsonObject SoakMonitor::report(const QStringList& failures) const
+{
+    const auto& diagnostics = Diagnostics::instance();
+    const qint64 elapsed_ms = clock_.elapsed();
+    const quint64 frames = diagnostics.frames() - start_frames_;
+
+    // Least-squares slope of the history-adjusted RSS from the end of warm-up on.
+    double slope = 0.0;
+    int points = 0;
+    double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+    for (const Sample& sample : samples_) {
+        if (sample.rss_bytes < 0) {
+            continue;
+        }
+        const double x = sample.elapsed_ms / 3600000.0;
+        const double y = toMiB(sample.rss_bytes - sample.history_bytes);
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+        ++points;
+    }
+    if (points >= 2 && points * sxx - sx * sx > 0.0) {
+        slope = (points * sxy - sx * sy) / (points * sxx - sx * sx);
+    }
+
+    const QJsonObject memory{{QStringLiteral("start_mb"), toMiB(start_rss_)},
+                             {QStringLiteral("warm_mb"), toMiB(samples_.first().rss_bytes)},
+                             {QStringLiteral("end_mb"), toMiB(samples_.last().rss_bytes)},
+                             {QStringLiteral("peak_mb"), toMiB(peak_rss_)},
+                             {QStringLiteral("history_mb"), toMiB(samples_.last().history_bytes)},
+                             {QStringLiteral("growth_mb"), growthMb()},
+                             {QStringLiteral("growth_mb_per_hour"), slope}};
+
+    QJsonArray intervals;
+    for (const Sample& sample : samples_) {
+        intervals.append(QJsonObject{{QStringLiteral("elapsed_s"), sample.elapsed_ms / 1000.0},
+                                     {QStringLiteral("rss_mb"), toMiB(sample.rss_bytes)},
+                                     {QStringLiteral("history_mb"), toMiB(sample.history_bytes)},
+                                     {QStringLiteral("frames"), static_cast<qint64>(sample.frames)},
+                                     {QStringLiteral("dropped_frames"), static_cast<qint64>(sample.dropped)},
+                                     {QStringLiteral("fps"), sample.fps},
+                                     {QStringLiteral("end_to_end"), latencyJson(sample.end_to_end)},
+                                     {QStringLiteral("paint"), latencyJson(sample.paint)}});
+    }
+
+    const auto buffers = diagnostics.frameBuffers();
+    return QJsonObject{
+        {QStringLiteral("passed"), failures.isEmpty()},
+        {QStringLiteral("failures"), QJsonArray::fromStringList(failures)},
+        {QStringLiteral("duration_s"), elapsed_ms / 1000.0},
+        {QStringLiteral("frames"), static_cast<qint64>(frames)},
+        {QStringLiteral("fps"), elapsed_ms > 0 ? frames * 1000.0 / elapsed_ms : 0.0},
+        {QStringLiteral("target_fps"), limits_.target_fps},
+        {QStringLiteral("dropped_frames"), static_cast<qint64>(diagnostics.droppedFrames() - start_dropped_)},
+        {QStringLiteral("coalesced_repaints"), static_cast<qint64>(diagnostics.coalescedRepaints() - start_coalesced_)},
+        {QStringLiteral("memory"), memory},
+        {QStringLiteral("end_to_end"), latencyJson(LatencyHistogram::summaryBetween(
+                                           start_end_to_end_, diagnostics.snapshot(Diagnostics::Stage::EndToEnd)))},
+        {QStringLiteral("paint"), latencyJson(LatencyHistogram::summaryBetween(
+                                      start_paint_, diagnostics.snapshot(Diagnostics::Stage::Paint)))},
+        {QStringLiteral("decode"), latencyJson(LatencyHistogram::summaryBetween(
+                                       start_decode_, diagnostics.snapshot(Diagnostics::Stage::Decode)))},
+        {QStringLiteral("frame_buffers"), QJsonObject{{QStringLiteral("high_water"), buffers.high_water},
+                                                      {QStringLiteral("capacity"), buffers.capacity},
+                                                      {QStringLiteral("exhausted"), static_cast<qint64>(buffers.exhausted)}}},
+        {QStringLiteral("intervals"), intervals}};
+}
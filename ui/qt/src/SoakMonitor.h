@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Diagnostics.h"
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+class DetectionStore;
+
+// Drives `gmti_visualizer --soak <minutes>`: while the full pipeline runs, samples resident
+// memory, frame rate and frame-time percentiles at regular intervals, then reports whether
+// the run leaked or slowed down. The first interval is warm-up (pools, caches and the
+// renderer settle), and growth of the detection history is subtracted, since it fills
+// its budget by design.
+class SoakMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Limits
+    {
+        // Resident memory growth allowed after warm-up, beyond the detection history's.
+        double max_rss_growth_mb = 64.0;
+        // Largest allowed ratio of the last interval's end-to-end p99 to the first's
+        // after warm-up.
+        double max_p99_ratio = 2.0;
+        // Frames per second every interval after warm-up must reach (within 10%); 0 only
+        // requires frames to arrive.
+        double target_fps = 0.0;
+    };
+
+    // One interval, ending `elapsed_ms` into the run.
+    struct Sample
+    {
+        qint64 elapsed_ms = 0;
+        qint64 rss_bytes = -1;
+        qint64 history_bytes = 0;
+        quint64 frames = 0;
+        quint64 dropped = 0;
+        double fps = 0.0;
+        LatencyHistogram::Summary end_to_end;
+        LatencyHistogram::Summary paint;
+    };
+
+    // `history` may be null; it must outlive the monitor.
+    SoakMonitor(double minutes, const Limits& limits, const DetectionStore* history, QObject* parent = nullptr);
+
+    // The JSON report is also written here when the run ends.
+    void setReportPath(const QString& path) { report_path_ = path; }
+    void start();
+
+    // Resident set size of this process, or -1 where the platform offers no cheap query.
+    static qint64 residentBytes();
+
+signals:
+    // The run is over and reported; `passed` says whether it stayed within every limit.
+    void finished(bool passed);
+
+private:
+    void takeSample();
+    void finish();
+    // Resident growth from the end of warm-up to the last sample, net of the detection
+    // history's; at least one sample must exist.
+    double growthMb() const;
+    QJsonObject report(const QStringList& failures) const;
+
+    qint64 duration_ms_;
+    Limits limits_;
+    const DetectionStore* history_;
+    QString report_path_;
+    QTimer sample_timer_;
+    QTimer end_timer_;
+    QElapsedTimer clock_;
+    QVector<Sample> samples_;
+    qint64 start_rss_ = -1;
+    qint64 peak_rss_ = -1;
+    // Counters and histograms at the previous sample, and at start for whole-run figures.
+    quint64 last_frames_ = 0;
+    quint64 last_dropped_ = 0;
+    quint64 start_frames_ = 0;
+    quint64 start_dropped_ = 0;
+    quint64 start_coalesced_ = 0;
+    LatencyHistogram::Snapshot last_end_to_end_;
+    LatencyHistogram::Snapshot last_paint_;
+    LatencyHistogram::Snapshot start_end_to_end_;
+    LatencyHistogram::Snapshot start_paint_;
+    LatencyHistogram::Snapshot start_decode_;
+};
@@ -1,57 +1,145 @@
 #include "StatusGraph.h"
 
+#include "Diagnostics.h"
+#include "ProfileKernels.h"
+#include "RenderScheduler.h"
+
 #include <QFont>
 #include <QLinearGradient>
 #include <QPainter>
 #include <QPaintEvent>
 #include <QPen>
-#include <QPolygonF>
-#include <algorithm>
+#include <QResizeEvent>
 
 StatusGraph::StatusGraph(QWidget* parent)
     : QWidget(parent)
 {
     setMinimumHeight(120);
+    // Every pixel comes from frame_, so Qt does not need to erase before painting.
+    setAttribute(Qt::WA_OpaquePaintEvent);
 }
 
-void StatusGraph::updateData(const QVector<double>& profile, int detectionCount)
+void StatusGraph::updateData(const FrameSnapshot& frame)
 {
-    profile_ = profile;
-    detection_count_ = detectionCount;
-    update();
+    profile_ = frame.profile;
+    detection_count_ = frame.detection_count;
+    max_value_ = frame.peak;
+    pending_origin_us_ = frame.origin_us;
+    pending_dispatch_us_ = frame.dispatched_us;
+    // Decimation waits for the paint, so frames superseded before the tick cost nothing.
+    data_dirty_ = true;
+    frame_ = QPixmap();
+    RenderScheduler::instance().requestUpdate(this);
 }
 
-void StatusGraph::paintEvent(QPaintEvent*)
+void StatusGraph::resizeEvent(QResizeEvent* event)
 {
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing, true);
+    QWidget::resizeEvent(event);
+    background_ = QPixmap();
+    frame_ = QPixmap();
+    if (data_dirty_) {
+        return;
+    }
+    if (event->size().width() != columns_width_) {
+        rebuildColumns(event->size().width());
+    }
+    rebuildTrace();
+}
+
+void StatusGraph::rebuildColumns(int width)
+{
+    columns_width_ = width;
+    levels_.clear();
+    const int samples = profile_.size();
+    if (samples == 0 || width <= 0) {
+        return;
+    }
+
+    const float scale = max_value_ > 0.0f ? 1.0f / max_value_ : 0.0f;
+
+    // With fewer than two samples per pixel every sample can be drawn as-is.
+    decimated_ = samples > 2 * width;
+    if (!decimated_) {
+        levels_.resize(samples);
+        ProfileKernels::scale(profile_.constData(), samples, scale, levels_.data());
+        return;
+    }
+
+    // Keep the min and max of each column so narrow peaks (CFAR hits) stay visible.
+    levels_.resize(2 * width);
+    ProfileKernels::columnMinMax(profile_.constData(), samples, width, scale, levels_.data());
+}
+
+void StatusGraph::rebuildTrace()
+{
+    const QRect area = rect();
+    const int count = levels_.size();
+    const int pointsPerX = decimated_ ? 2 : 1;
+    const int columns = count / pointsPerX;
+    trace_.resize(count);
+    ProfileKernels::toScreen(levels_.constData(), count, pointsPerX, area.left(),
+                             (area.width() - 1.0) / qMax(1, columns - 1), area.bottom(), area.height(),
+                             trace_.data());
+}
+
+void StatusGraph::renderBackground()
+{
+    const qreal ratio = devicePixelRatioF();
+    background_ = QPixmap(size() * ratio);
+    background_.setDevicePixelRatio(ratio);
+    QPainter painter(&background_);
     QLinearGradient gradient(rect().topLeft(), rect().bottomRight());
     gradient.setColorAt(0.0, QColor(22, 22, 22));
     gradient.setColorAt(1.0, QColor(44, 44, 44));
     painter.fillRect(rect(), gradient);
+}
 
+void StatusGraph::renderFrame()
+{
+    if (background_.isNull()) {
+        renderBackground();
+    }
+    frame_ = background_.copy();
+    frame_.setDevicePixelRatio(background_.devicePixelRatio());
+
+    QPainter painter(&frame_);
+    painter.setRenderHint(QPainter::Antialiasing, true);
     if (!profile_.isEmpty()) {
-        const auto maxValue = *std::max_element(profile_.cbegin(), profile_.cend());
-        const qreal height = rect().height();
-        const qreal width = rect().width();
-        QPolygonF line;
-        for (int i = 0; i < profile_.size(); ++i) {
-            qreal x = rect().left() + (width - 1.0) * i / qMax(1, profile_.size() - 1);
-            qreal normalized = maxValue > 0.0 ? profile_[i] / maxValue : 0.0;
-            qreal y = rect().bottom() - normalized * height;
-            line.append({x, y});
-        }
         QPen signalPen(QColor(0, 190, 255));
-        signalPen.setWidthF(2.0);
+        // Decimated traces are one vertical span per pixel; antialiasing only blurs them.
+        signalPen.setWidthF(decimated_ ? 1.0 : 2.0);
+        painter.setRenderHint(QPainter::Antialiasing, !decimated_);
         painter.setPen(signalPen);
-        painter.drawPolyline(line);
+        painter.drawPolyline(trace_);
+        painter.setRenderHint(QPainter::Antialiasing, true);
     } else {
         painter.setPen(Qt::gray);
         painter.drawText(rect(), Qt::AlignCenter, tr("Awaiting data..."));
     }
 
     painter.setPen(Qt::white);
-    painter.setFont(QFont(painter.font().family(), 10, QFont::Bold));
+    painter.setFont(QFont(font().family(), 10, QFont::Bold));
     painter.drawText(rect().adjusted(12, 10, -12, -10), Qt::AlignTop | Qt::AlignRight,
                      tr("Detections: %1").arg(detection_count_));
 }
+
+void StatusGraph::paintEvent(QPaintEvent* event)
+{
+    if (data_dirty_) {
+        rebuildColumns(width());
+        rebuildTrace();
+        data_dirty_ = false;
+    }
+    if (frame_.isNull()) {
+        renderFrame();
+    }
+    QPainter painter(this);
+    painter.drawPixmap(event->rect(), frame_, QRectF(event->rect().topLeft() * frame_.devicePixelRatio(),
+                                                     event->rect().size() * frame_.devicePixelRatio()));
+    if (pending_dispatch_us_ != 0) {
+        const qint64 now = Diagnostics::nowUs();
+        Diagnostics::instance().record(Diagnostics::Stage::Paint, now - pending_dispatch_us_);
+        Diagnostics::instance().record(Diagnostics::Stage::EndToEnd, now - pending_origin_us_);
+        pending_dispatch_us_ = 0;
+    }
+}
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "FrameSnapshot.h"
+
+#include <QPixmap>
+#include <QPolygonF>
 #include <QVector>
 #include <QWidget>
 
@@ -11,13 +15,34 @@ public:
     explicit StatusGraph(QWidget* parent = nullptr);
 
 public slots:
-    void updateData(const QVector<double>& profile, int detectionCount);
+    void updateData(const FrameSnapshot& frame);
 
 protected:
     void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
 
 private:
-    QVector<double> profile_;
+    void rebuildColumns(int width);
+    void rebuildTrace();
+    void renderBackground();
+    void renderFrame();
+
+    QVector<float> profile_;
+    float max_value_ = 0.0f;
+    // Normalized [0, 1] trace levels: one per sample, or a low/high pair per pixel column
+    // when decimated.
+    QVector<float> levels_;
+    int columns_width_ = -1;
+    bool decimated_ = false;
+    QPolygonF trace_;
+    // Gradient only, invalidated on resize; frame_ adds trace and labels and is also
+    // invalidated by new data, so an expose-only repaint is a single blit of frame_.
+    QPixmap background_;
+    QPixmap frame_;
     int detection_count_ = 0;
-};
+    // profile_ is newer than columns_/trace_; rebuilt on the next paint.
+    bool data_dirty_ = false;
+    // Pipeline stamps of the newest frame not yet painted; 0 once its paint is recorded.
+    qint64 pending_origin_us_ = 0;
+    qint64 pending_dispatch_us_ = 0;
 };
@@ -0,0 +1,238 @@
+#include "SweepDialog.h"
+
+#include <QBoxLayout>
+#include <QComboBox>
+#include <QDir>
+#include <QFile>
+#include <QFileDialog>
+#include <QFormLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTableWidget>
+
+namespace
+{
+enum Mode
+{
+    GridMode,
+    FilesMode
+};
+
+enum ResultColumn
+{
+    ScenarioColumn,
+    TapsColumn,
+    RangeColumn,
+    DopplerColumn,
+    NoiseColumn,
+    DetectionsColumn,
+    LatencyColumn,
+    StatusColumn,
+    ResultColumnCount
+};
+
+template <typename T, typename Convert>
+QVector<T> parseList(const QString& text, Convert convert)
+{
+    QVector<T> values;
+    for (const QString& part : text.split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+        bool ok = false;
+        const T value = convert(part.trimmed(), &ok);
+        if (ok) {
+            values.append(value);
+        }
+    }
+    return values;
+}
+
+QVector<int> parseIntList(const QString& text)
+{
+    return parseList<int>(text, [](const QString& s, bool* ok) { return s.toInt(ok); });
+}
+
+QVector<double> parseDoubleList(const QString& text)
+{
+    return parseList<double>(text, [](const QString& s, bool* ok) { return s.toDouble(ok); });
+}
+} // namespace
+
+SweepDialog::SweepDialog(EndpointPool* network, const QUrl& endpoint, QWidget* parent)
+    : QDialog(parent)
+    , runner_(new SweepRunner(network, endpoint, this))
+    , mode_combo_(new QComboBox(this))
+    , taps_edit_(new QLineEdit(QStringLiteral("2, 4, 8"), this))
+    , range_edit_(new QLineEdit(QStringLiteral("1024, 2048"), this))
+    , doppler_edit_(new QLineEdit(QStringLiteral("128, 256"), this))
+    , noise_edit_(new QLineEdit(QStringLiteral("0.01, 0.03, 0.07"), this))
+    , in_flight_spin_(new QSpinBox(this))
+    , run_button_(new QPushButton(tr("Run Sweep"), this))
+    , cancel_button_(new QPushButton(tr("Cancel"), this))
+    , export_button_(new QPushButton(tr("Export CSV..."), this))
+    , progress_(new QProgressBar(this))
+    , summary_label_(new QLabel(this))
+    , results_table_(new QTableWidget(0, ResultColumnCount, this))
+{
+    setWindowTitle(tr("Scenario Sweep"));
+    resize(760, 520);
+
+    mode_combo_->addItem(tr("Parameter grid"), GridMode);
+    mode_combo_->addItem(tr("All scenario files"), FilesMode);
+    in_flight_spin_->setRange(1, 6);
+    in_flight_spin_->setValue(4);
+    in_flight_spin_->setToolTip(tr("Requests kept in flight against the bridge"));
+
+    auto* form = new QFormLayout();
+    form->addRow(tr("Mode"), mode_combo_);
+    form->addRow(tr("Taps"), taps_edit_);
+    form->addRow(tr("Range bins"), range_edit_);
+    form->addRow(tr("Doppler bins"), doppler_edit_);
+    form->addRow(tr("Noise level"), noise_edit_);
+    form->addRow(tr("In flight"), in_flight_spin_);
+
+    results_table_->setHorizontalHeaderLabels({tr("Scenario"), tr("Taps"), tr("Range bins"), tr("Doppler bins"),
+                                               tr("Noise"), tr("Detections"), tr("Latency (ms)"), tr("Status")});
+    results_table_->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    results_table_->verticalHeader()->setVisible(false);
+    results_table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+    auto* buttons = new QHBoxLayout();
+    buttons->addWidget(run_button_);
+    buttons->addWidget(cancel_button_);
+    buttons->addStretch(1);
+    buttons->addWidget(export_button_);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addLayout(form);
+    layout->addLayout(buttons);
+    layout->addWidget(progress_);
+    layout->addWidget(summary_label_);
+    layout->addWidget(results_table_, 1);
+
+    connect(mode_combo_, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &SweepDialog::updateControls);
+    connect(run_button_, &QPushButton::clicked, this, &SweepDialog::onRun);
+    connect(cancel_button_, &QPushButton::clicked, runner_, &SweepRunner::cancel);
+    connect(export_button_, &QPushButton::clicked, this, &SweepDialog::onExport);
+    connect(runner_, &SweepRunner::resultReady, this, &SweepDialog::onResult);
+    connect(runner_, &SweepRunner::progress, this, [this](int completed, int total) {
+        progress_->setRange(0, qMax(1, total));
+        progress_->setValue(completed);
+    });
+    connect(runner_, &SweepRunner::finished, this, [this]() {
+        int ok = 0;
+        qint64 latency = 0;
+        for (const auto& result : runner_->results()) {
+            if (result.completed && result.ok) {
+                ++ok;
+                latency += result.latency_ms;
+            }
+        }
+        summary_label_->setText(tr("%1 of %2 runs succeeded, mean latency %3 ms")
+                                    .arg(ok)
+                                    .arg(runner_->results().size())
+                                    .arg(ok > 0 ? latency / ok : 0));
+        updateControls();
+    });
+    updateControls();
+}
+
+void SweepDialog::setBaseScenario(const Scenario& scenario)
+{
+    base_ = scenario;
+}
+
+void SweepDialog::setScenarioDirectory(const QString& path)
+{
+    scenario_directory_ = path;
+}
+
+QVector<Scenario> SweepDialog::buildJobs()
+{
+    if (mode_combo_->currentData().toInt() == FilesMode) {
+        QVector<Scenario> jobs;
+        const QDir dir(scenario_directory_);
+        for (const auto& file : dir.entryInfoList(QStringList{QStringLiteral("*.yaml")}, QDir::Files)) {
+            Scenario scenario;
+            if (ScenarioFile::load(file.absoluteFilePath(), base_, &scenario)) {
+                jobs.append(scenario);
+            }
+        }
+        return jobs;
+    }
+
+    return SweepRunner::gridSweep(base_, parseIntList(taps_edit_->text()), parseIntList(range_edit_->text()),
+                                  parseIntList(doppler_edit_->text()), parseDoubleList(noise_edit_->text()));
+}
+
+void SweepDialog::onRun()
+{
+    const QVector<Scenario> jobs = buildJobs();
+    if (jobs.isEmpty()) {
+        summary_label_->setText(tr("Nothing to run: check the parameter lists or scenario directory."));
+        return;
+    }
+
+    results_table_->setRowCount(0);
+    results_table_->setRowCount(jobs.size());
+    for (int row = 0; row < jobs.size(); ++row) {
+        const Scenario& scenario = jobs[row];
+        const QStringList cells = {scenario.name(),
+                                   QString::number(scenario.taps),
+                                   QString::number(scenario.range_bins),
+                                   QString::number(scenario.doppler_bins),
+                                   QString::number(scenario.noise),
+                                   QString(),
+                                   QString(),
+                                   tr("queued")};
+        for (int column = 0; column < cells.size(); ++column) {
+            results_table_->setItem(row, column, new QTableWidgetItem(cells[column]));
+        }
+    }
+    summary_label_->setText(tr("Running %1 scenarios...").arg(jobs.size()));
+    runner_->setMaxInFlight(in_flight_spin_->value());
+    runner_->start(jobs);
+    updateControls();
+}
+
+void SweepDialog::onResult(int index, const SweepRunner::Result& result)
+{
+    if (index >= results_table_->rowCount()) {
+        return;
+    }
+    results_table_->item(index, DetectionsColumn)->setText(result.ok ? QString::number(result.detections) : QString());
+    results_table_->item(index, LatencyColumn)->setText(QString::number(result.latency_ms));
+    results_table_->item(index, StatusColumn)->setText(result.ok ? tr("ok") : result.error);
+}
+
+void SweepDialog::onExport()
+{
+    const QString path =
+        QFileDialog::getSaveFileName(this, tr("Export Sweep Results"), QStringLiteral("sweep.csv"), tr("CSV (*.csv)"));
+    if (path.isEmpty()) {
+        return;
+    }
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        QMessageBox::warning(this, tr("Export Sweep Results"), tr("Cannot write %1: %2").arg(path, file.errorString()));
+        return;
+    }
+    file.write(SweepRunner::toCsv(runner_->results()).toUtf8());
+}
+
+void SweepDialog::updateControls()
+{
+    const bool running = runner_->isRunning();
+    const bool grid = mode_combo_->currentData().toInt() == GridMode;
+    for (QLineEdit* edit : {taps_edit_, range_edit_, doppler_edit_, noise_edit_}) {
+        edit->setEnabled(grid && !running);
+    }
+    mode_combo_->setEnabled(!running);
+    in_flight_spin_->setEnabled(!running);
+    run_button_->setEnabled(!running);
+    cancel_button_->setEnabled(running);
+    export_button_->setEnabled(!running && !runner_->results().isEmpty());
+}
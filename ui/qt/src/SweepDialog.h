@@ -0,0 +1,51 @@
+#pragma once
+
+#include "ScenarioFile.h"
+#include "SweepRunner.h"
+
+#include <QDialog>
+
+class EndpointPool;
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QProgressBar;
+class QPushButton;
+class QSpinBox;
+class QTableWidget;
+
+// Batch front end for SweepRunner: sweeps a parameter grid around the configurator's
+// current scenario, or every YAML file in the scenario directory, and tabulates results.
+class SweepDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    SweepDialog(EndpointPool* network, const QUrl& endpoint, QWidget* parent = nullptr);
+
+    void setBaseScenario(const Scenario& scenario);
+    void setScenarioDirectory(const QString& path);
+
+private:
+    QVector<Scenario> buildJobs();
+    void onRun();
+    void onExport();
+    void onResult(int index, const SweepRunner::Result& result);
+    void updateControls();
+
+    SweepRunner* runner_;
+    Scenario base_;
+    QString scenario_directory_;
+    QComboBox* mode_combo_;
+    QLineEdit* taps_edit_;
+    QLineEdit* range_edit_;
+    QLineEdit* doppler_edit_;
+    QLineEdit* noise_edit_;
+    QSpinBox* in_flight_spin_;
+    QPushButton* run_button_;
+    QPushButton* cancel_button_;
+    QPushButton* export_button_;
+    QProgressBar* progress_;
+    QLabel* summary_label_;
+    QTableWidget* results_table_;
+};
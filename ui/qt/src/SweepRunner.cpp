@@ -0,0 +1,191 @@
+#include "SweepRunner.h"
+
+#include "EndpointPool.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QStringList>
+
+namespace
+{
+// QNetworkAccessManager opens at most six HTTP/1.1 connections per host; anything past
+// that would just queue inside Qt and inflate the measured latency.
+constexpr int kMaxParallelRequests = 6;
+constexpr int kRequestTimeoutMs = 30000;
+// Pause before resubmitting jobs the bridge rejected with a full queue.
+constexpr int kBusyRetryMs = 100;
+
+QString requestId(int sweepId, int index)
+{
+    return QStringLiteral("sweep-%1-%2").arg(sweepId).arg(index);
+}
+
+QString csvField(QString value)
+{
+    if (value.contains(QLatin1Char(',')) || value.contains(QLatin1Char('"')) || value.contains(QLatin1Char('\n'))) {
+        value.replace(QLatin1String("\""), QLatin1String("\"\""));
+        return QLatin1Char('"') + value + QLatin1Char('"');
+    }
+    return value;
+}
+} // namespace
+
+SweepRunner::SweepRunner(EndpointPool* network, const QUrl& endpoint, QObject* parent)
+    : QObject(parent)
+    , network_(network)
+    , endpoint_(endpoint)
+{
+    retry_timer_.setSingleShot(true);
+    retry_timer_.setInterval(kBusyRetryMs);
+    connect(&retry_timer_, &QTimer::timeout, this, &SweepRunner::submitNext);
+}
+
+QVector<Scenario> SweepRunner::gridSweep(const Scenario& base, const QVector<int>& taps, const QVector<int>& rangeBins,
+                                         const QVector<int>& dopplerBins, const QVector<double>& noise)
+{
+    QVector<Scenario> jobs;
+    jobs.reserve(taps.size() * rangeBins.size() * dopplerBins.size() * noise.size());
+    for (int t : taps) {
+        for (int r : rangeBins) {
+            for (int d : dopplerBins) {
+                for (double n : noise) {
+                    Scenario scenario = base;
+                    scenario.taps = t;
+                    scenario.range_bins = r;
+                    scenario.doppler_bins = d;
+                    scenario.noise = n;
+                    jobs.append(scenario);
+                }
+            }
+        }
+    }
+    return jobs;
+}
+
+void SweepRunner::setMaxInFlight(int count)
+{
+    max_in_flight_ = qBound(1, count, kMaxParallelRequests);
+}
+
+void SweepRunner::start(const QVector<Scenario>& jobs)
+{
+    cancel();
+    jobs_ = jobs;
+    results_ = QVector<Result>(jobs.size());
+    next_ = 0;
+    completed_ = 0;
+    retry_.clear();
+    ++sweep_id_;
+    clock_.start();
+    emit progress(0, jobs_.size());
+    if (jobs_.isEmpty()) {
+        emit finished();
+        return;
+    }
+    submitNext();
+}
+
+void SweepRunner::cancel()
+{
+    // Drop anything not yet sent, then abort what is on the wire.
+    next_ = jobs_.size();
+    // Jobs waiting only on a retry have no reply whose abort would report the cancel.
+    const bool waitingOnRetry = in_flight_ == 0 && !retry_.isEmpty();
+    retry_.clear();
+    retry_timer_.stop();
+    const auto replies = replies_;
+    for (QNetworkReply* reply : replies) {
+        reply->abort();
+    }
+    if (waitingOnRetry) {
+        emit finished();
+    }
+}
+
+void SweepRunner::submitNext()
+{
+    while (in_flight_ < max_in_flight_ && (!retry_.isEmpty() || next_ < jobs_.size())) {
+        const int index = !retry_.isEmpty() ? retry_.takeFirst() : next_++;
+        const Scenario& scenario = jobs_[index];
+        // Sweeps stay reproducible: scenarios without a seed get one derived from their slot.
+        const quint64 seed = scenario.seed != 0 ? scenario.seed : static_cast<quint64>(index + 1);
+        results_[index].scenario = scenario;
+        results_[index].seed = seed;
+
+        QNetworkRequest request = network_->request(endpoint_, kRequestTimeoutMs);
+        request.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("application/json"));
+        request.setRawHeader("X-Request-Id", requestId(sweep_id_, index).toUtf8());
+        auto* reply = network_->post(request, QJsonDocument(scenario.toGeneratorConfig(seed)).toJson(QJsonDocument::Compact));
+        replies_.append(reply);
+        ++in_flight_;
+        const qint64 startedAt = clock_.elapsed();
+        connect(reply, &QNetworkReply::finished, this,
+                [this, reply, index, startedAt]() { onReplyFinished(reply, index, startedAt); });
+    }
+}
+
+void SweepRunner::onReplyFinished(QNetworkReply* reply, int index, qint64 startedAt)
+{
+    reply->deleteLater();
+    replies_.removeOne(reply);
+    --in_flight_;
+
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 503) {
+        // Every bridge worker is busy and its queue is full; try this job again shortly.
+        retry_.append(index);
+        retry_timer_.start();
+        return;
+    }
+
+    Result& result = results_[index];
+    result.latency_ms = clock_.elapsed() - startedAt;
+    result.completed = true;
+    result.ok = reply->error() == QNetworkReply::NoError;
+    if (result.ok) {
+        const QJsonObject body = QJsonDocument::fromJson(reply->readAll()).object();
+        result.detections = body.value(QStringLiteral("detections")).toInt(-1);
+        result.request_id = body.value(QStringLiteral("request_id")).toString();
+        if (result.request_id != requestId(sweep_id_, index)) {
+            result.ok = false;
+            result.error = tr("reply tagged %1 does not match its request").arg(result.request_id);
+        }
+    } else {
+        result.error = reply->errorString();
+    }
+    ++completed_;
+    emit resultReady(index, result);
+    emit progress(completed_, jobs_.size());
+
+    submitNext();
+    if (in_flight_ == 0 && next_ >= jobs_.size()) {
+        emit finished();
+    }
+}
+
+QString SweepRunner::toCsv(const QVector<Result>& results)
+{
+    QStringList lines;
+    lines.reserve(results.size() + 1);
+    lines.append(QStringLiteral("scenario,taps,range_bins,doppler_bins,frequency,noise,seed,status,detections,latency_ms"));
+    for (const Result& result : results) {
+        if (!result.completed) {
+            continue;
+        }
+        const Scenario& s = result.scenario;
+        lines.append(QStringList{csvField(s.name()),
+                                 QString::number(s.taps),
+                                 QString::number(s.range_bins),
+                                 QString::number(s.doppler_bins),
+                                 QString::number(s.frequency),
+                                 QString::number(s.noise),
+                                 QString::number(result.seed),
+                                 result.ok ? QStringLiteral("ok") : csvField(result.error),
+                                 QString::number(result.detections),
+                                 QString::number(result.latency_ms)}
+                         .join(QLatin1Char(',')));
+    }
+    return lines.join(QLatin1Char('\n')) + QLatin1Char('\n');
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "ScenarioFile.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <QUrl>
+#include <QVector>
+
+class EndpointPool;
+class QNetworkReply;
+
+// Submits a queue of scenarios to POST /ingest-config, keeping up to `maxInFlight`
+// requests outstanding on the shared EndpointPool, and records per-run results. Each
+// request carries an X-Request-Id the bridge echoes back; jobs the bridge turns away
+// because its worker queue is full (503) are resubmitted shortly after.
+class SweepRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Result
+    {
+        Scenario scenario;
+        quint64 seed = 0;
+        // False for jobs that were never answered (still queued or cancelled).
+        bool completed = false;
+        bool ok = false;
+        // Tag sent with the job; only set once the bridge echoed it back.
+        QString request_id;
+        int detections = -1;
+        qint64 latency_ms = 0;
+        QString error;
+    };
+
+    SweepRunner(EndpointPool* network, const QUrl& endpoint, QObject* parent = nullptr);
+
+    // Cartesian product of the parameter lists over `base`.
+    static QVector<Scenario> gridSweep(const Scenario& base, const QVector<int>& taps, const QVector<int>& rangeBins,
+                                       const QVector<int>& dopplerBins, const QVector<double>& noise);
+
+    void setMaxInFlight(int count);
+    bool isRunning() const { return in_flight_ > 0 || next_ < jobs_.size() || !retry_.isEmpty(); }
+    const QVector<Result>& results() const { return results_; }
+
+    void start(const QVector<Scenario>& jobs);
+    void cancel();
+
+    static QString toCsv(const QVector<Result>& results);
+
+signals:
+    void resultReady(int index, const SweepRunner::Result& result);
+    void progress(int completed, int total);
+    void finished();
+
+private:
+    void submitNext();
+    void onReplyFinished(QNetworkReply* reply, int index, qint64 startedAt);
+
+    EndpointPool* network_;
+    QUrl endpoint_;
+    QVector<Scenario> jobs_;
+    QVector<Result> results_;
+    QVector<QNetworkReply*> replies_;
+    // Busy-rejected job indices, sent again before any new job.
+    QVector<int> retry_;
+    QTimer retry_timer_;
+    QElapsedTimer clock_;
+    int max_in_flight_ = 4;
+    int in_flight_ = 0;
+    int next_ = 0;
+    int completed_ = 0;
+    int sweep_id_ = 0;
+};
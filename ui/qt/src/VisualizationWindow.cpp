@@ -1,25 +1,290 @@
 #include "VisualizationWindow.h"
 
+#include "ChannelView.h"
+#include "ClientOptions.h"
 #include "DataProvider.h"
+#include "DetectionScatter.h"
+#include "DetectionStore.h"
+#include "DetectionTableModel.h"
+#include "DiagnosticsPanel.h"
+#include "EndpointPool.h"
+#include "EngineMetrics.h"
+#include "EngineMetricsView.h"
 #include "InputConfigurator.h"
-#include "StatusGraph.h"
+#include "SoakMonitor.h"
+#include <QCoreApplication>
+#include <QComboBox>
+#include <QDoubleSpinBox>
+#include <QHeaderView>
+#include <QItemSelection>
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QSplitter>
+#include <QTableView>
+#include <QStringList>
+#include <QTimer>
 #include <QVBoxLayout>
+#include <QtMath>
 
-VisualizationWindow::VisualizationWindow(QWidget* parent)
+#ifdef GMTI_HAVE_OPENGL
+#include "GlStatusGraph.h"
+#endif
+
+namespace
+{
+bool useGpuRenderer(ClientOptions::Renderer renderer)
+{
+#ifdef GMTI_HAVE_OPENGL
+    switch (renderer) {
+    case ClientOptions::Renderer::Gpu:
+        return true;
+    case ClientOptions::Renderer::Software:
+        return false;
+    case ClientOptions::Renderer::Auto:
+        break;
+    }
+    return GlStatusGraph::isSupported();
+#else
+    Q_UNUSED(renderer);
+    return false;
+#endif
+}
+
+QString transportName(DataProvider::Transport transport)
+{
+    switch (transport) {
+    case DataProvider::Transport::Streaming:
+        return VisualizationWindow::tr("Streaming");
+    case DataProvider::Transport::Replay:
+        return VisualizationWindow::tr("Replay");
+    case DataProvider::Transport::Polling:
+        break;
+    }
+    return VisualizationWindow::tr("Polling");
+}
+} // namespace
+
+VisualizationWindow::VisualizationWindow(const ClientOptions& options, QWidget* parent)
     : QWidget(parent)
 {
     auto* layout = new QVBoxLayout(this);
     layout->setContentsMargins(12, 12, 12, 12);
     layout->setSpacing(10);
 
-    auto* configurator = new InputConfigurator(this);
+    // Every bridge request and channel shares one network layer and a few decoder threads.
+    auto* endpoints = new EndpointPool(0, this);
+    endpoints->setHttp2Direct(options.http2);
+    endpoints->setFrameBuffers(options.frame_buffers);
+
+    // Scenario runs, sweeps and capture ingest drive the first endpoint's engine, the one
+    // recording, replay and the engine metrics chart also follow.
+    auto* configurator = new InputConfigurator(endpoints, options.endpoints.first().url, this);
     layout->addWidget(configurator);
 
-    auto* statusGraph = new StatusGraph(this);
-    statusGraph->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-    layout->addWidget(statusGraph, 1);
+    const bool gpu = useGpuRenderer(options.renderer);
+    const bool multiChannel = options.endpoints.size() > 1;
+    QVector<DataProvider*> providers;
+    QStringList channelNames;
+    auto* channels = new QWidget(this);
+    auto* channelGrid = new QGridLayout(channels);
+    channelGrid->setContentsMargins(0, 0, 0, 0);
+    channelGrid->setSpacing(10);
+    const int gridColumns = qCeil(qSqrt(options.endpoints.size()));
+    for (const ClientOptions::Endpoint& endpoint : options.endpoints) {
+        auto* provider = new DataProvider(endpoints, endpoint.url, this);
+        // A lone channel keeps the original uncaptioned layout.
+        auto* view = new ChannelView(multiChannel ? QStringLiteral("%1 (%2)").arg(endpoint.name, endpoint.url.authority())
+                                                  : QString(),
+                                     gpu, channels);
+        connect(provider, &DataProvider::dataReady, view, &ChannelView::updateData);
+        const int index = providers.size();
+        channelGrid->addWidget(view, index / gridColumns, index % gridColumns);
+        providers.append(provider);
+        channelNames.append(endpoint.name);
+    }
+    layout->addWidget(channels, 2);
+
+    // Detection history shared by the table and the scatter; both read its columns. Rows
+    // are tagged with the index of the channel they came from.
+    auto* detections = new DetectionStore(qint64(options.detection_memory_mb) << 20, this);
+    for (int i = 0; i < providers.size(); ++i) {
+        connect(providers[i], &DataProvider::dataReady, detections,
+                [detections, i](const FrameSnapshot& frame) { detections->append(frame.records, i); });
+    }
+
+    auto* detectionSplitter = new QSplitter(Qt::Horizontal, this);
+    auto* detectionTable = new QTableView(detectionSplitter);
+    auto* detectionModel = new DetectionTableModel(detections, detectionTable);
+    detectionModel->setChannelNames(channelNames);
+    detectionTable->setModel(detectionModel);
+    detectionTable->setColumnHidden(DetectionTableModel::ChannelColumn, !multiChannel);
+    detectionTable->verticalHeader()->setDefaultSectionSize(20);
+    detectionTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    detectionTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    detectionTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    detectionSplitter->addWidget(detectionTable);
+    auto* scatter = new DetectionScatter(detections, detectionSplitter);
+    scatter->setChannelNames(channelNames);
+    detectionSplitter->addWidget(scatter);
+    connect(scatter, &DetectionScatter::detectionsSelected, detectionTable,
+            [detectionTable, detectionModel](const QVector<int>& storeRows) {
+                // The scatter and the table share a filter, so every pick has a table row.
+                QVector<int> rows;
+                rows.reserve(storeRows.size());
+                for (int storeRow : storeRows) {
+                    if (const int row = detectionModel->tableRow(storeRow); row >= 0) {
+                        rows.append(row);
+                    }
+                }
+                QAbstractItemModel* model = detectionModel;
+                if (rows.isEmpty()) {
+                    detectionTable->clearSelection();
+                    return;
+                }
+                // The table pages rows in lazily; pull in enough to reach the last pick.
+                while (model->rowCount() <= rows.last() && model->canFetchMore(QModelIndex())) {
+                    model->fetchMore(QModelIndex());
+                }
+                // Rows arrive sorted, so contiguous runs collapse into one selection range.
+                const int lastColumn = model->columnCount() - 1;
+                QItemSelection selection;
+                for (int i = 0; i < rows.size();) {
+                    int j = i;
+                    while (j + 1 < rows.size() && rows[j + 1] == rows[j] + 1) {
+                        ++j;
+                    }
+                    selection.select(model->index(rows[i], 0), model->index(rows[j], lastColumn));
+                    i = j + 1;
+                }
+                detectionTable->selectionModel()->select(selection, QItemSelectionModel::ClearAndSelect);
+                detectionTable->scrollTo(model->index(rows.first(), DetectionTableModel::TimeColumn));
+            });
+    detectionSplitter->setStretchFactor(0, 3);
+    detectionSplitter->setStretchFactor(1, 2);
+
+    // History filter applied to both views; windows are relative to each channel's newest
+    // detection, since engines' clocks are independent.
+    auto* windowCombo = new QComboBox(this);
+    windowCombo->addItem(tr("All history"), 0.0);
+    windowCombo->addItem(tr("Last 10 s"), 10.0);
+    windowCombo->addItem(tr("Last 60 s"), 60.0);
+    windowCombo->addItem(tr("Last 5 min"), 300.0);
+    windowCombo->addItem(tr("Last 15 min"), 900.0);
+    auto* snrSpin = new QDoubleSpinBox(this);
+    snrSpin->setRange(0.0, 60.0);
+    snrSpin->setDecimals(1);
+    snrSpin->setSuffix(tr(" dB"));
+    // 0 is the minimum, so the special text stands in for it.
+    snrSpin->setSpecialValueText(tr("any"));
+    auto* channelCombo = new QComboBox(this);
+    channelCombo->addItem(tr("All channels"), -1);
+    for (int i = 0; i < channelNames.size(); ++i) {
+        channelCombo->addItem(channelNames[i], i);
+    }
+    channelCombo->setVisible(multiChannel);
+    auto* historyLabel = new QLabel(this);
+    historyLabel->setStyleSheet("color: #999999;");
+    auto applyFilter = [detectionModel, scatter, windowCombo, snrSpin, channelCombo]() {
+        const double window = windowCombo->currentData().toDouble();
+        const float minSnr = snrSpin->value() > 0.0 ? static_cast<float>(snrSpin->value())
+                                                     : -std::numeric_limits<float>::infinity();
+        const int channel = channelCombo->currentData().toInt();
+        detectionModel->setFilter(window, minSnr, channel);
+        scatter->setFilter(window, minSnr, channel);
+    };
+    connect(windowCombo, &QComboBox::currentIndexChanged, this, applyFilter);
+    connect(snrSpin, &QDoubleSpinBox::valueChanged, this, applyFilter);
+    connect(channelCombo, &QComboBox::currentIndexChanged, this, applyFilter);
+    auto* historyTimer = new QTimer(this);
+    historyTimer->setInterval(1000);
+    connect(historyTimer, &QTimer::timeout, this, [detections, historyLabel]() {
+        historyLabel->setText(tr("%1 detections held, %2 of %3 MiB")
+                                  .arg(detections->size())
+                                  .arg(detections->memoryUsed() >> 20)
+                                  .arg(detections->memoryBudget() >> 20));
+    });
+    historyTimer->start();
+    auto* historyBar = new QHBoxLayout();
+    historyBar->addWidget(new QLabel(tr("Detections:"), this));
+    historyBar->addWidget(windowCombo);
+    historyBar->addWidget(new QLabel(tr("Min SNR"), this));
+    historyBar->addWidget(snrSpin);
+    historyBar->addWidget(channelCombo);
+    historyBar->addStretch(1);
+    historyBar->addWidget(historyLabel);
+    layout->addLayout(historyBar);
+    layout->addWidget(detectionSplitter, 1);
+
+    if (options.show_diagnostics) {
+        layout->addWidget(new DiagnosticsPanel(this));
+    }
+    if (options.show_engine_metrics) {
+        auto* metrics = new EngineMetrics(endpoints, options.endpoints.first().url, this);
+        auto* metricsView = new EngineMetricsView(120, this);
+        connect(metrics, &EngineMetrics::sampleReady, metricsView, &EngineMetricsView::addSample);
+        connect(metrics, &EngineMetrics::availabilityChanged, metricsView, &EngineMetricsView::setAvailable);
+        layout->addWidget(metricsView);
+        metrics->start();
+    }
+
+    // Refreshed on a timer rather than per frame so the label never drives relayouts.
+    auto* linkStatus = new QLabel(this);
+    linkStatus->setStyleSheet("color: #aaaaaa;");
+    layout->addWidget(linkStatus);
+    auto* statusTimer = new QTimer(this);
+    connect(statusTimer, &QTimer::timeout, this, [endpoints, providers, channelNames, linkStatus]() {
+        QStringList parts;
+        for (int i = 0; i < providers.size(); ++i) {
+            const auto stats = providers[i]->statistics();
+            QString part = tr("%1 | frames %2 | dropped %3 | coalesced %4 | poll %5 ms")
+                               .arg(transportName(providers[i]->transport()))
+                               .arg(stats.frames)
+                               .arg(stats.dropped)
+                               .arg(stats.coalesced)
+                               .arg(stats.poll_interval_ms);
+            parts.append(providers.size() > 1 ? QStringLiteral("%1: %2").arg(channelNames[i], part) : part);
+        }
+        const auto network = endpoints->statistics();
+        parts.append(tr("%1 requests on %2 connections").arg(network.requests).arg(network.connections));
+        linkStatus->setText(parts.join(QStringLiteral("   ")));
+    });
+    statusTimer->start(500);
+
+    // Replay and recording apply to the first channel; the rest always go live.
+    for (int i = 0; i < providers.size(); ++i) {
+        DataProvider* provider = providers[i];
+        if (i == 0 && !options.replay_path.isEmpty()) {
+            QString error;
+            if (provider->startReplay(options.replay_path, options.replay_speed, options.replay_loop, &error)) {
+                continue;
+            }
+            qWarning("Cannot replay %s: %s", qPrintable(options.replay_path), qPrintable(error));
+        }
+        if (i == 0 && !options.record_path.isEmpty()) {
+            QString error;
+            if (!provider->setRecordingPath(options.record_path, &error)) {
+                qWarning("Cannot record to %s: %s", qPrintable(options.record_path), qPrintable(error));
+            }
+        }
+        provider->setStreamingEnabled(options.streaming);
+        provider->setWireFormat(options.wire_format);
+        if (options.soak_fps > 0.0) {
+            // A fixed poll rate, so a polled soak runs at the target instead of adapting.
+            const int interval = qMax(1, qRound(1000.0 / options.soak_fps));
+            provider->setPollIntervalBounds(interval, interval);
+            provider->start(interval);
+        } else {
+            provider->start();
+        }
+    }
 
-    auto* dataProvider = new DataProvider(this);
-    connect(dataProvider, &DataProvider::dataReady, statusGraph, &StatusGraph::updateData);
-    dataProvider->start();
+    if (options.soak_minutes > 0.0) {
+        SoakMonitor::Limits limits;
+        limits.target_fps = options.soak_fps;
+        auto* soak = new SoakMonitor(options.soak_minutes, limits, detections, this);
+        soak->setReportPath(options.soak_report);
+        connect(soak, &SoakMonitor::finished, this, [](bool passed) { QCoreApplication::exit(passed ? 0 : 1); });
+        soak->start();
+    }
 }
@@ -2,10 +2,12 @@
 
 #include <QWidget>
 
+struct ClientOptions;
+
 class VisualizationWindow : public QWidget
 {
     Q_OBJECT
 
 public:
-    explicit VisualizationWindow(QWidget* parent = nullptr);
+    explicit VisualizationWindow(const ClientOptions& options, QWidget* parent = nullptr);
 };
@@ -0,0 +1,130 @@
+#include "WaterfallView.h"
+
+#include "ProfileKernels.h"
+#include "RenderScheduler.h"
+
+#include <QColor>
+#include <QPainter>
+#include <QPaintEvent>
+#include <cstring>
+
+namespace
+{
+// Wider profiles are max-decimated so a CFAR hit in any bin still lights its column.
+constexpr int kMaxColumns = 2048;
+constexpr float kDynamicRangeDb = 50.0f;
+constexpr float kReferenceSmoothing = 0.1f;
+
+QVector<QRgb> buildPalette()
+{
+    // Piecewise-linear ramp; the 0.6 stop is the StatusGraph trace colour.
+    struct Stop
+    {
+        qreal at;
+        QColor colour;
+    };
+    const Stop stops[] = {{0.0, QColor(10, 10, 40)},
+                          {0.35, QColor(0, 90, 200)},
+                          {0.6, QColor(0, 190, 255)},
+                          {0.85, QColor(255, 220, 0)},
+                          {1.0, QColor(255, 255, 255)}};
+
+    QVector<QRgb> palette(256);
+    int stop = 0;
+    for (int i = 0; i < palette.size(); ++i) {
+        const qreal t = i / 255.0;
+        while (t > stops[stop + 1].at) {
+            ++stop;
+        }
+        const Stop& a = stops[stop];
+        const Stop& b = stops[stop + 1];
+        const qreal f = (t - a.at) / (b.at - a.at);
+        palette[i] = qRgb(qRound(a.colour.red() + f * (b.colour.red() - a.colour.red())),
+                          qRound(a.colour.green() + f * (b.colour.green() - a.colour.green())),
+                          qRound(a.colour.blue() + f * (b.colour.blue() - a.colour.blue())));
+    }
+    return palette;
+}
+} // namespace
+
+WaterfallView::WaterfallView(int historyRows, QWidget* parent)
+    : QWidget(parent)
+    , palette_(buildPalette())
+    , history_rows_(qMax(1, historyRows))
+{
+    setMinimumHeight(160);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+void WaterfallView::resetImage(int columns)
+{
+    image_ = QImage(columns, history_rows_, QImage::Format_RGB32);
+    image_.fill(palette_.first());
+    row_.resize(columns);
+    levels_.resize(columns);
+    head_ = 0;
+    filled_ = 0;
+}
+
+void WaterfallView::quantizeRow(const QVector<float>& profile, float peak)
+{
+    const int bins = profile.size();
+    const int columns = row_.size();
+    float peakDb;
+    ProfileKernels::toDecibels(&peak, 1, &peakDb);
+    // Track the peak slowly so the colour scale does not flicker from frame to frame.
+    reference_db_ = filled_ == 0 ? peakDb : reference_db_ + kReferenceSmoothing * (peakDb - reference_db_);
+    const float floorDb = reference_db_ - kDynamicRangeDb;
+    const float scale = 255.0f / kDynamicRangeDb;
+
+    const float* power = profile.constData();
+    if (columns < bins) {
+        ProfileKernels::columnMax(power, bins, columns, levels_.data());
+        power = levels_.constData();
+    }
+    ProfileKernels::toDecibels(power, columns, levels_.data());
+    ProfileKernels::colourMap(levels_.constData(), columns, floorDb, scale, palette_.constData(), row_.data());
+}
+
+void WaterfallView::updateData(const FrameSnapshot& frame)
+{
+    const QVector<float>& profile = frame.profile;
+    if (profile.isEmpty()) {
+        return;
+    }
+    // The image is only reallocated when the engine changes its range bin count.
+    if (profile.size() != source_bins_) {
+        source_bins_ = profile.size();
+        resetImage(qMin(source_bins_, kMaxColumns));
+    }
+
+    quantizeRow(profile, frame.peak);
+    head_ = (head_ + history_rows_ - 1) % history_rows_;
+    std::memcpy(image_.scanLine(head_), row_.constData(), row_.size() * sizeof(QRgb));
+    filled_ = qMin(filled_ + 1, history_rows_);
+    // Every row is kept; only the repaint is deferred to the display tick.
+    RenderScheduler::instance().requestUpdate(this);
+}
+
+void WaterfallView::paintEvent(QPaintEvent*)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(22, 22, 22));
+    if (filled_ == 0) {
+        painter.setPen(Qt::gray);
+        painter.drawText(rect(), Qt::AlignCenter, tr("Awaiting data..."));
+        return;
+    }
+
+    // One screen row per history row (scaled to fit), newest at the top.
+    const qreal rowHeight = static_cast<qreal>(height()) / history_rows_;
+    const int newerRows = qMin(filled_, history_rows_ - head_);
+    const int olderRows = filled_ - newerRows;
+    const qreal w = width();
+    painter.drawImage(QRectF(0, 0, w, newerRows * rowHeight), image_,
+                      QRectF(0, head_, image_.width(), newerRows));
+    if (olderRows > 0) {
+        painter.drawImage(QRectF(0, newerRows * rowHeight, w, olderRows * rowHeight), image_,
+                          QRectF(0, 0, image_.width(), olderRows));
+    }
+}
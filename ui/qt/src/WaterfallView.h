@@ -0,0 +1,40 @@
+#pragma once
+
+#include "FrameSnapshot.h"
+
+#include <QImage>
+#include <QVector>
+#include <QWidget>
+
+// Scrolling range/time waterfall. The last `historyRows` profiles live in a preallocated
+// ring of image rows, so memory stays fixed no matter how long the session runs.
+class WaterfallView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit WaterfallView(int historyRows = 512, QWidget* parent = nullptr);
+
+public slots:
+    void updateData(const FrameSnapshot& frame);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    void resetImage(int columns);
+    void quantizeRow(const QVector<float>& profile, float peak);
+
+    QImage image_;
+    QVector<QRgb> row_;
+    // Per-column peak power, then its dB level, for the row being quantized.
+    QVector<float> levels_;
+    QVector<QRgb> palette_;
+    int history_rows_;
+    int source_bins_ = 0;
+    // Row holding the newest profile; the ring is written bottom to top so that rows
+    // [head_, end) followed by [0, head_) read newest to oldest.
+    int head_ = 0;
+    int filled_ = 0;
+    float reference_db_ = 0.0f;
+};
@@ -1,13 +1,186 @@
 #include <QApplication>
 #include <QColor>
+#include <QCommandLineParser>
 #include <QPalette>
 #include <QStyleFactory>
+#include "ClientOptions.h"
+#include "Diagnostics.h"
 #include "VisualizationWindow.h"
 
+namespace
+{
+ClientOptions parseOptions(const QApplication& app)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("GMTI Qt visualizer"));
+    parser.addHelpOption();
+    const QCommandLineOption binaryOption(QStringLiteral("binary-frames"),
+                                          QStringLiteral("Request packed binary frames instead of JSON."));
+    const QCommandLineOption pollOption(QStringLiteral("poll-only"),
+                                        QStringLiteral("Disable the /stream push transport and poll /payload."));
+    const QCommandLineOption rendererOption(QStringLiteral("renderer"),
+                                            QStringLiteral("Profile renderer: auto, gpu or software."),
+                                            QStringLiteral("mode"), QStringLiteral("auto"));
+    const QCommandLineOption diagnosticsOption(QStringLiteral("diagnostics"),
+                                               QStringLiteral("Show the pipeline latency diagnostics panel."));
+    const QCommandLineOption diagnosticsJsonOption(QStringLiteral("diagnostics-json"),
+                                                   QStringLiteral("Write latency histograms to <file> on exit."),
+                                                   QStringLiteral("file"));
+    const QCommandLineOption recordOption(QStringLiteral("record"),
+                                          QStringLiteral("Append every raw bridge reply to <file> for later replay."),
+                                          QStringLiteral("file"));
+    const QCommandLineOption replayOption(QStringLiteral("replay"),
+                                          QStringLiteral("Replay a recording made with --record instead of connecting."),
+                                          QStringLiteral("file"));
+    const QCommandLineOption replaySpeedOption(QStringLiteral("replay-speed"),
+                                               QStringLiteral("Replay speed factor, or \"max\" for as fast as possible."),
+                                               QStringLiteral("factor"), QStringLiteral("1"));
+    const QCommandLineOption replayLoopOption(QStringLiteral("replay-loop"),
+                                              QStringLiteral("Restart the replay when the recording ends."));
+    const QCommandLineOption endpointOption(
+        QStringLiteral("endpoint"),
+        QStringLiteral("Bridge to fan frames in from, as name=http://host:port; repeat for several engines."),
+        QStringLiteral("name=url"));
+    const QCommandLineOption http2Option(QStringLiteral("http2"),
+                                         QStringLiteral("Talk HTTP/2 (h2c) to the bridges instead of HTTP/1.1."));
+    parser.addOption(endpointOption);
+    parser.addOption(http2Option);
+    parser.addOption(binaryOption);
+    parser.addOption(pollOption);
+    parser.addOption(rendererOption);
+    const QCommandLineOption engineMetricsOption(
+        QStringLiteral("engine-metrics"), QStringLiteral("Chart the engine's per-stage timings from /metrics."));
+    parser.addOption(diagnosticsOption);
+    parser.addOption(engineMetricsOption);
+    parser.addOption(diagnosticsJsonOption);
+    parser.addOption(recordOption);
+    parser.addOption(replayOption);
+    parser.addOption(replaySpeedOption);
+    const QCommandLineOption detectionMemoryOption(
+        QStringLiteral("detection-memory"), QStringLiteral("Detection history budget in MiB (default 128)."),
+        QStringLiteral("MiB"), QStringLiteral("128"));
+    parser.addOption(replayLoopOption);
+    parser.addOption(detectionMemoryOption);
+    const QCommandLineOption frameBuffersOption(
+        QStringLiteral("frame-buffers"),
+        QStringLiteral("Reusable frame buffers per decoder (default 8); see the diagnostics high-water mark."),
+        QStringLiteral("count"), QStringLiteral("8"));
+    parser.addOption(frameBuffersOption);
+    const QCommandLineOption headlessOption(
+        QStringLiteral("headless"), QStringLiteral("Render offscreen without showing a window (for soak runs)."));
+    const QCommandLineOption soakOption(
+        QStringLiteral("soak"),
+        QStringLiteral("Run for <minutes>, then report memory growth, frame times and drops and exit; the exit "
+                       "code is 1 if the run leaked or slowed down."),
+        QStringLiteral("minutes"));
+    const QCommandLineOption soakFpsOption(QStringLiteral("soak-fps"),
+                                           QStringLiteral("Frame rate the soak run must sustain."),
+                                           QStringLiteral("fps"));
+    const QCommandLineOption soakReportOption(QStringLiteral("soak-report"),
+                                              QStringLiteral("Write the soak report as JSON to <file>."),
+                                              QStringLiteral("file"));
+    parser.addOption(headlessOption);
+    parser.addOption(soakOption);
+    parser.addOption(soakFpsOption);
+    parser.addOption(soakReportOption);
+    parser.process(app);
+
+    ClientOptions options;
+    for (const QString& spec : parser.values(endpointOption)) {
+        const int split = spec.indexOf(QLatin1Char('='));
+        ClientOptions::Endpoint endpoint;
+        endpoint.name = split > 0 ? spec.left(split) : QStringLiteral("engine%1").arg(options.endpoints.size() + 1);
+        endpoint.url = QUrl(split > 0 ? spec.mid(split + 1) : spec);
+        if (!endpoint.url.isValid() || endpoint.url.host().isEmpty()) {
+            qWarning("Ignoring invalid --endpoint %s", qPrintable(spec));
+            continue;
+        }
+        options.endpoints.append(endpoint);
+    }
+    if (options.endpoints.isEmpty()) {
+        options.endpoints.append({QStringLiteral("main"), QUrl(QStringLiteral("http://127.0.0.1:9000"))});
+    }
+    options.streaming = !parser.isSet(pollOption);
+    options.http2 = parser.isSet(http2Option);
+    if (parser.isSet(binaryOption)) {
+        options.wire_format = DataProvider::WireFormat::Binary;
+    }
+    const QString renderer = parser.value(rendererOption);
+    if (renderer == QLatin1String("gpu")) {
+        options.renderer = ClientOptions::Renderer::Gpu;
+    } else if (renderer == QLatin1String("software")) {
+        options.renderer = ClientOptions::Renderer::Software;
+    }
+    options.show_diagnostics = parser.isSet(diagnosticsOption);
+    options.show_engine_metrics = parser.isSet(engineMetricsOption);
+    options.diagnostics_json = parser.value(diagnosticsJsonOption);
+    options.record_path = parser.value(recordOption);
+    options.replay_path = parser.value(replayOption);
+    options.replay_loop = parser.isSet(replayLoopOption);
+    const QString speed = parser.value(replaySpeedOption);
+    if (speed == QLatin1String("max")) {
+        options.replay_speed = 0.0;
+    } else {
+        bool ok = false;
+        options.replay_speed = speed.toDouble(&ok);
+        if (!ok || options.replay_speed <= 0.0) {
+            qWarning("Invalid --replay-speed %s; using 1", qPrintable(speed));
+            options.replay_speed = 1.0;
+        }
+    }
+    bool memoryOk = false;
+    const int detectionMemory = parser.value(detectionMemoryOption).toInt(&memoryOk);
+    if (memoryOk && detectionMemory > 0) {
+        options.detection_memory_mb = detectionMemory;
+    } else {
+        qWarning("Invalid --detection-memory %s; using %d", qPrintable(parser.value(detectionMemoryOption)),
+                 options.detection_memory_mb);
+    }
+    bool buffersOk = false;
+    const int frameBuffers = parser.value(frameBuffersOption).toInt(&buffersOk);
+    if (buffersOk && frameBuffers > 0) {
+        options.frame_buffers = frameBuffers;
+    } else {
+        qWarning("Invalid --frame-buffers %s; using %d", qPrintable(parser.value(frameBuffersOption)),
+                 options.frame_buffers);
+    }
+    options.headless = parser.isSet(headlessOption);
+    if (parser.isSet(soakOption)) {
+        bool soakOk = false;
+        options.soak_minutes = parser.value(soakOption).toDouble(&soakOk);
+        if (!soakOk || options.soak_minutes <= 0.0) {
+            qWarning("Invalid --soak %s; running until closed", qPrintable(parser.value(soakOption)));
+            options.soak_minutes = 0.0;
+        }
+    }
+    if (parser.isSet(soakFpsOption)) {
+        bool fpsOk = false;
+        options.soak_fps = parser.value(soakFpsOption).toDouble(&fpsOk);
+        if (!fpsOk || options.soak_fps < 0.0) {
+            qWarning("Invalid --soak-fps %s; ignoring", qPrintable(parser.value(soakFpsOption)));
+            options.soak_fps = 0.0;
+        }
+    }
+    options.soak_report = parser.value(soakReportOption);
+    // A recording is usually far shorter than a soak run.
+    if (options.soak_minutes > 0.0 && !options.replay_path.isEmpty()) {
+        options.replay_loop = true;
+    }
+    return options;
+}
+} // namespace
+
 int main(int argc, char** argv)
 {
+    // The platform plugin is picked when QApplication is constructed, before option parsing.
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], "--headless") == 0 && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        }
+    }
     QApplication app(argc, argv);
     QApplication::setStyle(QStyleFactory::create("Fusion"));
+    const ClientOptions options = parseOptions(app);
 
     QPalette darkPalette;
     darkPalette.setColor(QPalette::Window, QColor(18, 18, 18));
@@ -21,7 +194,11 @@ int main(int argc, char** argv)
     darkPalette.setColor(QPalette::HighlightedText, Qt::black);
     app.setPalette(darkPalette);
 
-    VisualizationWindow window;
+    VisualizationWindow window(options);
     window.show();
-    return app.exec();
+    const int status = app.exec();
+    if (!options.diagnostics_json.isEmpty() && !Diagnostics::instance().writeJson(options.diagnostics_json)) {
+        qWarning("Cannot write diagnostics to %s", qPrintable(options.diagnostics_json));
+    }
+    return status;
 }